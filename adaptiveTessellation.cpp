@@ -0,0 +1,85 @@
+#include "adaptiveTessellation.h"
+#include "math.h"
+
+// distance from the point to the segment AB
+static double distanceToSegment( vec3 point, vec3 a, vec3 b ){
+	vec3 ab = b.soustraction( a );
+	vec3 ap = point.soustraction( a );
+	double length = ab.produitScalaire( ab );
+	if( length == 0 ){
+		return ap.norme();
+	}
+	double t = ap.produitScalaire( ab ) / length;
+	t = t < 0 ? 0 : ( t > 1 ? 1 : t );
+	return ap.soustraction( ab.multiplication( t ) ).norme();
+}
+
+double flatness( std::deque<vec3> & controlPoints ){
+	double result = 0;
+	int last = controlPoints.size()-1;
+	for( int i = 1; i < last; i++ ){
+		double distance = distanceToSegment( controlPoints[i], controlPoints[0], controlPoints[last] );
+		result = distance > result ? distance : result;
+	}
+	return result;
+}
+
+double flatness( const vec3 * controlPoints, int amount ){
+	double result = 0;
+	int last = amount-1;
+	for( int i = 1; i < last; i++ ){
+		double distance = distanceToSegment( controlPoints[i], controlPoints[0], controlPoints[last] );
+		result = distance > result ? distance : result;
+	}
+	return result;
+}
+
+double pixelsToWorld( double pixels, double left, double right, double bottom, double top, int width, int height ){
+	// the largest of both axes, so that the tolerance holds in every direction
+	double unitsX = width > 0 ? fabs( right-left )/width : 0;
+	double unitsY = height > 0 ? fabs( top-bottom )/height : 0;
+	return pixels * ( unitsX > unitsY ? unitsX : unitsY );
+}
+
+adaptiveTessellator::adaptiveTessellator( double tolerance, int maxDepth ) {
+	this->tolerance = tolerance;
+	this->maxDepth = maxDepth;
+	this->left.resize( maxDepth );
+	this->right.resize( maxDepth );
+}
+
+void adaptiveTessellator::setTolerance( double tolerance ) {
+	this->tolerance = tolerance;
+}
+double adaptiveTessellator::getTolerance() const {
+	return this->tolerance;
+}
+
+void adaptiveTessellator::split( std::deque<vec3> & controlPoints, int depth, std::vector<vec3> & vertices ) {
+	if( depth >= this->maxDepth || flatness( controlPoints ) <= this->tolerance ){
+		vertices.push_back( controlPoints[controlPoints.size()-1] );
+		return;
+	}
+	this->evaluator.subdivide( 0.5, controlPoints, this->left[depth], this->right[depth] );
+	this->split( this->left[depth], depth+1, vertices );
+	this->split( this->right[depth], depth+1, vertices );
+}
+
+void adaptiveTessellator::tessellate( std::deque<vec3> & controlPoints, std::vector<vec3> & vertices ) {
+	vertices.clear();
+	vertices.push_back( controlPoints[0] );
+	this->split( controlPoints, 0, vertices );
+}
+
+void adaptiveTessellator::tessellate( const curveView & controlPoints, std::vector<vec3> & vertices ) {
+	// the halves are deques, the curve is copied once into the root
+	this->root.assign( controlPoints.begin(), controlPoints.end() );
+	this->tessellate( this->root, vertices );
+}
+
+std::deque<vec3> adaptive( std::deque<vec3> controlPoints, double tolerance ){
+	adaptiveTessellator tessellator( tolerance );
+	std::vector<vec3> vertices;
+	tessellator.tessellate( controlPoints, vertices );
+	return std::deque<vec3>( vertices.begin(), vertices.end() );
+}
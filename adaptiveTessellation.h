@@ -0,0 +1,45 @@
+#include <deque>
+#include <vector>
+#include "vec3.h"
+#include "casteljau.h"
+#include "curveView.h"
+
+#pragma once
+
+// largest distance from the inner control points to the chord P0-Pn (the curve lies within it, convex hull property)
+double flatness( std::deque<vec3> & controlPoints );
+double flatness( const vec3 * controlPoints, int amount );
+
+// size in world units of the given amount of pixels, for a glOrtho( left, right, bottom, top ) mapped on a width x height viewport
+double pixelsToWorld( double pixels, double left, double right, double bottom, double top, int width, int height );
+
+/**
+ *	Adaptive tessellation of a Bezier curve: the curve is split in two (de Casteljau at 0.5)
+ * until the control polygon of each piece is within tolerance of its chord, then the chords
+ * are emitted as a single vertex stream (P0, then the end of each flat piece in order).
+ *
+ */
+class adaptiveTessellator
+{
+private:
+	casteljauEvaluator evaluator;
+	std::vector< std::deque<vec3> > left, right;	// halves of each depth, kept between calls
+	std::deque<vec3> root;				// copy of a curveView
+	double tolerance;
+	int maxDepth;
+
+	void split( std::deque<vec3> & controlPoints, int depth, std::vector<vec3> & vertices );
+
+public:
+	adaptiveTessellator( double tolerance = 0.01, int maxDepth = 16 );
+
+	void setTolerance( double tolerance );
+	double getTolerance() const;
+
+	// replaces vertices with the vertex stream of the curve
+	void tessellate( std::deque<vec3> & controlPoints, std::vector<vec3> & vertices );
+	void tessellate( const curveView & controlPoints, std::vector<vec3> & vertices );
+};
+
+// calculate the Bezier curve with the adaptive tessellation, tolerance in world units
+std::deque<vec3> adaptive( std::deque<vec3> controlPoints, double tolerance );
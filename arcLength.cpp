@@ -0,0 +1,168 @@
+#include "arcLength.h"
+#include "profiler.h"
+#include <algorithm>
+#include "math.h"
+
+int arcLengthTable::defaultIntervals = 32;
+int arcLengthTable::newtonSteps = 3;
+
+// 5-point Gauss-Legendre nodes and weights on [-1,1]
+static const double gaussNodes[5] = { -0.9061798459386640, -0.5384693101056831, 0., 0.5384693101056831, 0.9061798459386640 };
+static const double gaussWeights[5] = { 0.2369268850561891, 0.4786286704993665, 0.5688888888888889, 0.4786286704993665, 0.2369268850561891 };
+
+arcLengthTable::arcLengthTable() {
+}
+
+void arcLengthTable::build( const std::deque<vec3> & controlPoints, int intervals ) {
+	std::vector<vec3> points( controlPoints.begin(), controlPoints.end() );
+	this->build( curveView( points.data(), points.size() ), intervals );
+}
+
+void arcLengthTable::build( const curveView & controlPoints, int intervals ) {
+	// derivative: n*(P(i+1)-Pi), a single null vector for a point
+	int n = controlPoints.size()-1;
+	this->hodograph.resize( n > 0 ? n : 1 );
+	this->hodograph[0] = vec3();
+	for( int i = 0; i < n; i++ ){
+		this->hodograph[i] = ( controlPoints[i+1] - controlPoints[i] ) * (double)n;
+	}
+	this->evaluator.reserve( this->hodograph.size()-1 );
+
+	intervals = intervals < 1 ? 1 : intervals;
+	this->lengths.resize( intervals+1 );
+	this->lengths[0] = 0;
+	for( int k = 0; k < intervals; k++ ){
+		this->lengths[k+1] = this->lengths[k] + this->integrate( k/(double)intervals, (k+1)/(double)intervals );
+	}
+}
+
+int arcLengthTable::getAmountIntervals() const {
+	return this->lengths.size()-1;
+}
+
+double arcLengthTable::getLength() const {
+	return this->lengths.back();
+}
+
+double arcLengthTable::speed( double u ) {
+	return this->evaluator.evaluate( u, curveView( this->hodograph.data(), this->hodograph.size() ) ).norme();
+}
+
+double arcLengthTable::integrate( double u0, double u1 ) {
+	double half = (u1-u0)/2, middle = (u1+u0)/2;
+	double result = 0;
+	for( int i = 0; i < 5; i++ ){
+		result += gaussWeights[i] * this->speed( middle + half*gaussNodes[i] );
+	}
+	return result*half;
+}
+
+double arcLengthTable::lengthAt( double u ) {
+	u = u < 0 ? 0 : ( u > 1 ? 1 : u );
+	int intervals = this->getAmountIntervals();
+	int k = (int)( u*intervals );
+	k = k < intervals ? k : intervals-1;
+	return this->lengths[k] + this->integrate( k/(double)intervals, u );
+}
+
+double arcLengthTable::parameterAt( double distance ) {
+	int intervals = this->getAmountIntervals();
+	if( distance <= 0 ){
+		return 0;
+	}
+	if( distance >= this->getLength() ){
+		return 1;
+	}
+	// interval k holds the distance: lengths[k] <= distance < lengths[k+1]
+	int k = std::upper_bound( this->lengths.begin(), this->lengths.end(), distance ) - this->lengths.begin() - 1;
+	double u0 = k/(double)intervals, u1 = (k+1)/(double)intervals;
+	double local = distance - this->lengths[k];
+	double intervalLength = this->lengths[k+1] - this->lengths[k];
+
+	// linear guess in the interval, then Newton on s(u) - distance (s' is the speed)
+	double u = u0 + (u1-u0)*local/intervalLength;
+	for( int step = 0; step < newtonSteps; step++ ){
+		double velocity = this->speed( u );
+		if( velocity <= 0 ){
+			break;
+		}
+		u -= ( this->integrate( u0, u ) - local )/velocity;
+		u = u < u0 ? u0 : ( u > u1 ? u1 : u );
+	}
+	return u;
+}
+
+arcLengthCache::arcLengthCache() {
+}
+
+void arcLengthCache::resize( int amountCurves ) {
+	this->tables.resize( amountCurves );
+	this->valid.resize( amountCurves, false );
+}
+
+void arcLengthCache::invalidate( int curve ) {
+	if( curve >= 0 && curve < this->valid.size() ){
+		this->valid[curve] = false;
+	}
+}
+
+void arcLengthCache::invalidateAll() {
+	for( int i = 0; i < this->valid.size(); i++ ){
+		this->valid[i] = false;
+	}
+}
+
+arcLengthTable & arcLengthCache::get( int curve, const curveView & controlPoints ) {
+	if( curve >= this->tables.size() ){
+		this->resize( curve+1 );
+	}
+	if( this->valid[curve] ){
+		this->hits++;
+		PROFILE_COUNT( counterArcLengthHits, 1 );
+	}
+	else{
+		this->misses++;
+		PROFILE_COUNT( counterArcLengthMisses, 1 );
+		this->tables[curve].build( controlPoints );
+		this->valid[curve] = true;
+	}
+	return this->tables[curve];
+}
+
+long long arcLengthCache::getHits() const {
+	return this->hits;
+}
+long long arcLengthCache::getMisses() const {
+	return this->misses;
+}
+
+void sampleChainUniform( splineStore & curves, arcLengthCache & tables, int amount, vec3 * result ){
+	if( curves.size() == 0 || amount <= 0 ){
+		return;
+	}
+	// lengths of the curves, from their tables
+	std::vector<double> starts( curves.size()+1 );
+	starts[0] = 0;
+	for( int i = 0; i < curves.size(); i++ ){
+		starts[i+1] = starts[i] + tables.get( i, curves[i] ).getLength();
+	}
+	double total = starts.back();
+
+	// the distances increase with s, so the curve only moves forward
+	casteljauEvaluator evaluator;
+	int curve = 0;
+	for( int s = 0; s < amount; s++ ){
+		double distance = amount > 1 ? total*s/(amount-1) : 0;
+		while( curve < curves.size()-1 && distance > starts[curve+1] ){
+			curve++;
+		}
+		double u = tables.get( curve, curves[curve] ).parameterAt( distance - starts[curve] );
+		result[s] = evaluator.evaluate( u, curves[curve] );
+	}
+}
+
+std::deque<vec3> sampleChainUniform( splineStore & curves, arcLengthCache & tables, int amount ){
+	std::vector<vec3> points( amount > 0 ? amount : 0 );
+	sampleChainUniform( curves, tables, amount, points.data() );
+	return std::deque<vec3>( points.begin(), points.end() );
+}
@@ -0,0 +1,73 @@
+#include <deque>
+#include <vector>
+#include "vec3.h"
+#include "casteljau.h"
+#include "curveView.h"
+#include "splineStore.h"
+
+#pragma once
+
+/**
+ *	Arc length of a Bezier curve as a function of u, tabulated on uniform intervals of [0,1].
+ * The length of each interval is integrated with 5-point Gauss-Legendre quadrature on the speed |B'(u)|
+ * (the derivative is the Bezier curve of the differences n*(P(i+1)-Pi)). The inverse lookup finds the
+ * interval by binary search on the cumulative lengths, then refines u with Newton steps.
+ *
+ */
+class arcLengthTable
+{
+private:
+	std::vector<vec3> hodograph;	// control points of the derivative
+	std::vector<double> lengths;	// intervals+1 cumulative lengths, lengths[k] = s( k/intervals )
+	casteljauEvaluator evaluator;
+
+	// length between u0 and u1 (5-point Gauss-Legendre)
+	double integrate( double u0, double u1 );
+
+public:
+	static int defaultIntervals;
+	static int newtonSteps;
+
+	arcLengthTable();
+
+	void build( const std::deque<vec3> & controlPoints, int intervals = defaultIntervals );
+	void build( const curveView & controlPoints, int intervals = defaultIntervals );
+
+	int getAmountIntervals() const;
+	double getLength() const;
+
+	// |B'(u)|
+	double speed( double u );
+	// length of the curve between 0 and u
+	double lengthAt( double u );
+	// u at which the length from 0 reaches distance (clamped to [0, getLength()]), O(log intervals)
+	double parameterAt( double distance );
+};
+
+// Arc length tables of a list of curves, rebuilt only after invalidate() (as powerBasisCache)
+class arcLengthCache
+{
+private:
+	std::deque<arcLengthTable> tables;
+	std::deque<bool> valid;
+	long long hits = 0, misses = 0;
+
+public:
+	arcLengthCache();
+
+	void resize( int amountCurves );
+	// to be called when a control point of the curve moves
+	void invalidate( int curve );
+	void invalidateAll();
+
+	// obtains the table of the curve, building it if it was invalidated
+	arcLengthTable & get( int curve, const curveView & controlPoints );
+
+	long long getHits() const;
+	long long getMisses() const;
+};
+
+// amount points equally spaced by arc length along the whole chain of curves (the first and the last control
+// points included), written to result. Only the tables of the invalidated curves are rebuilt
+void sampleChainUniform( splineStore & curves, arcLengthCache & tables, int amount, vec3 * result );
+std::deque<vec3> sampleChainUniform( splineStore & curves, arcLengthCache & tables, int amount );
@@ -0,0 +1,161 @@
+#include "bernsteinBasis.h"
+#include "profiler.h"
+#include "curves.h"
+#include "highDegree.h"
+
+bernsteinBasis::bernsteinBasis( int degree, int amountSamples ) {
+	this->degree = degree;
+	this->amountSamples = amountSamples;
+
+	int amount = this->getAmountRows();
+	this->weights.resize( amount*(degree+1) );
+	// one row per sample in O(degree), valid for any degree
+	for( int s = 0; s < amount; s++ ){
+		bernsteinRow( degree, s/((double)amount-1), &this->weights[s*(degree+1)] );
+	}
+}
+
+int bernsteinBasis::getDegree() const {
+	return this->degree;
+}
+int bernsteinBasis::getAmountSamples() const {
+	return this->amountSamples;
+}
+int bernsteinBasis::getAmountRows() const {
+	return this->amountSamples+2;	// at least 2 samples, as in bernstein()
+}
+const double * bernsteinBasis::getRow( int sample ) const {
+	return &this->weights[sample*(this->degree+1)];
+}
+size_t bernsteinBasis::getBytes() const {
+	return this->weights.size()*sizeof(double);
+}
+
+std::deque<vec3> bernsteinBasis::evaluate( const std::deque<vec3> & controlPoints ) const {
+	std::deque<vec3> result( this->getAmountRows() );
+	std::vector<vec3> samples( this->getAmountRows() );
+	this->evaluate( controlPoints, &samples[0] );
+	for( int s = 0; s < samples.size(); s++ ){
+		result[s] = samples[s];
+	}
+	return result;
+}
+
+template<typename Points, typename T>
+void bernsteinBasis::evaluatePoints( const Points & controlPoints, vector3<T> * result ) const {
+	// control points unpacked once, the inner loop only reads contiguous doubles (scratch kept by each thread)
+	int n = this->degree+1;
+	static thread_local std::vector<double> coordinates;
+	if( (int)coordinates.size() < 3*n ){
+		coordinates.resize( 3*n );
+	}
+	for( int i = 0; i < n; i++ ){
+		coordinates[i] = controlPoints[i].getX();
+		coordinates[n+i] = controlPoints[i].getY();
+		coordinates[2*n+i] = controlPoints[i].getZ();
+	}
+	const double * px = &coordinates[0];
+	const double * py = px + n;
+	const double * pz = py + n;
+
+	int amount = this->getAmountRows();
+	for( int s = 0; s < amount; s++ ){
+		const double * w = this->getRow( s );
+		double x = px[0]*w[0], y = py[0]*w[0], z = pz[0]*w[0];
+		for( int i = 1; i < n; i++ ){
+			x += px[i]*w[i];
+			y += py[i]*w[i];
+			z += pz[i]*w[i];
+		}
+		result[s].set( x, y, z );
+	}
+}
+
+void bernsteinBasis::evaluate( const std::deque<vec3> & controlPoints, vec3 * result ) const {
+	this->evaluatePoints( controlPoints, result );
+}
+
+void bernsteinBasis::evaluate( const curveView & controlPoints, vec3 * result ) const {
+	this->evaluatePoints( controlPoints, result );
+}
+
+void bernsteinBasis::evaluate( const std::deque<vec3f> & controlPoints, vec3f * result ) const {
+	this->evaluatePoints( controlPoints, result );
+}
+
+void bernsteinBasis::evaluate( const curveViewF & controlPoints, vec3f * result ) const {
+	this->evaluatePoints( controlPoints, result );
+}
+
+void bernsteinBasis::evaluate( const std::deque<vec3> & controlPoints, vec3f * result ) const {
+	this->evaluatePoints( controlPoints, result );
+}
+
+void bernsteinBasis::evaluate( const curveView & controlPoints, vec3f * result ) const {
+	this->evaluatePoints( controlPoints, result );
+}
+
+bernsteinBasisCache::bernsteinBasisCache( size_t capacityBytes ) {
+	this->capacityBytes = capacityBytes;
+}
+
+std::shared_ptr<const bernsteinBasis> bernsteinBasisCache::get( int degree, int amountSamples ) {
+	std::lock_guard<std::mutex> lock( this->mutex );
+	key k( degree, amountSamples );
+
+	std::map<key, entry>::iterator found = this->tables.find( k );
+	if( found != this->tables.end() ){
+		this->hits++;
+		PROFILE_COUNT( counterBasisHits, 1 );
+		// moving the table to the front of the recent list
+		this->recent.splice( this->recent.begin(), this->recent, found->second.second );
+		return found->second.first;
+	}
+
+	this->misses++;
+	PROFILE_COUNT( counterBasisMisses, 1 );
+	PROFILE_COUNT( counterAllocations, 1 );
+	std::shared_ptr<const bernsteinBasis> table( new bernsteinBasis( degree, amountSamples ) );
+	// the tables in use elsewhere live on through their shared_ptr
+	while( !this->recent.empty() && this->bytes + table->getBytes() > this->capacityBytes ){
+		this->bytes -= this->tables[this->recent.back()].first->getBytes();
+		this->tables.erase( this->recent.back() );
+		this->recent.pop_back();
+	}
+	this->bytes += table->getBytes();
+	this->recent.push_front( k );
+	this->tables[k] = entry( table, this->recent.begin() );
+	return table;
+}
+
+void bernsteinBasisCache::clear() {
+	std::lock_guard<std::mutex> lock( this->mutex );
+	this->tables.clear();
+	this->recent.clear();
+	this->bytes = 0;
+}
+
+int bernsteinBasisCache::size() {
+	std::lock_guard<std::mutex> lock( this->mutex );
+	return this->tables.size();
+}
+
+size_t bernsteinBasisCache::getBytes() {
+	std::lock_guard<std::mutex> lock( this->mutex );
+	return this->bytes;
+}
+
+long long bernsteinBasisCache::getHits() {
+	std::lock_guard<std::mutex> lock( this->mutex );
+	return this->hits;
+}
+
+long long bernsteinBasisCache::getMisses() {
+	std::lock_guard<std::mutex> lock( this->mutex );
+	return this->misses;
+}
+
+bernsteinBasisCache & bernsteinBasisCache::shared() {
+	static bernsteinBasisCache cache;
+	return cache;
+}
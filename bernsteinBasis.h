@@ -0,0 +1,74 @@
+#include <deque>
+#include <vector>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include "vec3.h"
+#include "curveView.h"
+
+#pragma once
+
+// Bernstein weights of one degree sampled at the same parameters as bernstein( controlPoints, amountSamples )
+class bernsteinBasis
+{
+private:
+	int degree;
+	int amountSamples;
+	std::vector<double> weights;	// (amountSamples+2) x (degree+1), row s holds B(degree,i,u_s)
+
+	template<typename Points, typename T>
+	void evaluatePoints( const Points & controlPoints, vector3<T> * result ) const;
+
+public:
+	bernsteinBasis( int degree, int amountSamples );
+
+	int getDegree() const;
+	int getAmountSamples() const;
+	int getAmountRows() const;
+	const double * getRow( int sample ) const;
+	// memory of the weights
+	size_t getBytes() const;
+
+	// matrix-vector product of the weights with the control points
+	std::deque<vec3> evaluate( const std::deque<vec3> & controlPoints ) const;
+	void evaluate( const std::deque<vec3> & controlPoints, vec3 * result ) const;
+	void evaluate( const curveView & controlPoints, vec3 * result ) const;
+	// float samples, accumulated in double: from float control points, or from double ones into a float buffer
+	void evaluate( const std::deque<vec3f> & controlPoints, vec3f * result ) const;
+	void evaluate( const curveViewF & controlPoints, vec3f * result ) const;
+	void evaluate( const std::deque<vec3> & controlPoints, vec3f * result ) const;
+	void evaluate( const curveView & controlPoints, vec3f * result ) const;
+};
+
+// Thread-safe cache of basis tables keyed by (degree, amountSamples), bounded by the bytes of the weights
+// (least recently used first out, the last table obtained is always kept). Every get() takes the lock:
+// batch callers obtain the table once per (degree, amountSamples), not once per curve
+class bernsteinBasisCache
+{
+private:
+	typedef std::pair<int,int> key;
+	typedef std::pair< std::shared_ptr<const bernsteinBasis>, std::list<key>::iterator > entry;
+
+	std::mutex mutex;
+	size_t capacityBytes;
+	size_t bytes = 0;
+	std::list<key> recent;			// most recently used first
+	std::map<key, entry> tables;
+	long long hits = 0, misses = 0;
+
+public:
+	bernsteinBasisCache( size_t capacityBytes = 16 << 20 );
+
+	// obtains the table, creating it (and evicting the least recently used one) if needed
+	std::shared_ptr<const bernsteinBasis> get( int degree, int amountSamples );
+
+	void clear();
+	int size();
+	size_t getBytes();
+	long long getHits();
+	long long getMisses();
+
+	// cache shared by every bernstein() call
+	static bernsteinBasisCache & shared();
+};
@@ -0,0 +1,150 @@
+#include <deque>
+#include <vector>
+#include "vec3.h"
+#include "curves.h"
+#include "casteljau.h"
+#include "curveView.h"
+#include "bernsteinBasis.h"
+
+#pragma once
+
+/**
+ *	Bezier evaluators specialized on the degree at compile time.
+ * The binomial coefficients are constant expressions and the sum over the control points is unrolled
+ * by template recursion, so a quadratic or cubic sample is a handful of multiply-adds without factorial,
+ * pow or loop. bernsteinDispatch routes the degrees up to maxFixedDegree to these kernels and the
+ * other degrees to the generic evaluators. Templated on the precision of vector3 (vec3 or vec3f).
+ *
+ */
+
+// highest degree routed to bernsteinFixed by bernsteinDispatch
+const int maxFixedDegree = 3;
+
+// binomial coefficient C(n,k), usable in constant expressions
+constexpr double binomial( int n, int k ){
+	double result = 1;
+	for( int i = 1; i <= k; i++ ){
+		result = result * (n-k+i) / i;
+	}
+	return result;
+}
+
+static_assert( binomial( 2, 1 ) == 2 && binomial( 3, 1 ) == 3 && binomial( 3, 3 ) == 1, "binomial coefficients of the common degrees" );
+
+// x^N with N multiplications written out
+template<int N>
+struct fixedPower
+{
+	template<typename T>
+	static constexpr T of( T x ){ return x * fixedPower<N-1>::of( x ); }
+};
+
+template<>
+struct fixedPower<0>
+{
+	template<typename T>
+	static constexpr T of( T ){ return 1; }
+};
+
+// adds the terms I, I-1, ..., 0 of the Bernstein sum of the given degree ( C(Degree,i) * u^i * (1-u)^(Degree-i) * Pi )
+template<int Degree, int I>
+struct bernsteinTerms
+{
+	template<typename T>
+	static constexpr void accumulate( T u, T v, const vector3<T> * controlPoints, T & x, T & y, T & z ){
+		constexpr T coefficient = (T)binomial( Degree, I );
+		T weight = coefficient * fixedPower<I>::of( u ) * fixedPower<Degree-I>::of( v );
+		x += controlPoints[I].getX()*weight;
+		y += controlPoints[I].getY()*weight;
+		z += controlPoints[I].getZ()*weight;
+		bernsteinTerms<Degree, I-1>::accumulate( u, v, controlPoints, x, y, z );
+	}
+};
+
+template<int Degree>
+struct bernsteinTerms<Degree, -1>
+{
+	template<typename T>
+	static constexpr void accumulate( T, T, const vector3<T> *, T &, T &, T & ){}
+};
+
+// position on the Bezier curve of degree Degree (Degree+1 control points) related to the factor u [0,1]
+template<int Degree, typename T>
+constexpr vector3<T> bernsteinFixed( typename vector3<T>::scalar u, const vector3<T> * controlPoints ){
+	static_assert( Degree >= 0, "bernsteinFixed needs a degree of at least 0" );
+	T x = 0, y = 0, z = 0;
+	bernsteinTerms<Degree, Degree>::accumulate( u, 1-u, controlPoints, x, y, z );
+	return vector3<T>( x, y, z );
+}
+
+// amountSamples+2 uniform samples in [0,1] (same samples as bernstein()), written to result.
+// The samples are computed in the precision of the control points and stored in the one of result
+template<int Degree, typename T, typename R>
+void bernsteinFixed( const vector3<T> * controlPoints, int amountSamples, vector3<R> * result ){
+	int amount = amountSamples+2;
+	for( int s = 0; s < amount; s++ ){
+		result[s] = vector3<R>( bernsteinFixed<Degree>( s/((T)amount-1), controlPoints ) );
+	}
+}
+
+template<int Degree, typename T, typename R>
+void bernsteinFixed( const std::deque< vector3<T> > & controlPoints, int amountSamples, vector3<R> * result ){
+	// a deque is not contiguous, the control points are copied once for all the samples
+	vector3<T> points[Degree+1];
+	for( int i = 0; i <= Degree; i++ ){
+		points[i] = controlPoints[i];
+	}
+	bernsteinFixed<Degree>( (const vector3<T> *)points, amountSamples, result );
+}
+
+// position on the Bezier curve related to the factor u [0,1]: bernsteinFixed up to maxFixedDegree, de Casteljau above
+// (one scratch triangle per thread, no factorial or pow per sample)
+template<typename T>
+vector3<T> bernsteinDispatch( typename vector3<T>::scalar u, const std::deque< vector3<T> > & controlPoints ){
+	switch( (int)controlPoints.size()-1 ){
+		case 1: { vector3<T> points[2] = { controlPoints[0], controlPoints[1] }; return bernsteinFixed<1>( u, points ); }
+		case 2: { vector3<T> points[3] = { controlPoints[0], controlPoints[1], controlPoints[2] }; return bernsteinFixed<2>( u, points ); }
+		case 3: { vector3<T> points[4] = { controlPoints[0], controlPoints[1], controlPoints[2], controlPoints[3] }; return bernsteinFixed<3>( u, points ); }
+		default: {
+			static thread_local casteljauEvaluatorT<T> evaluator;
+			return evaluator.evaluate( u, controlPoints );
+		}
+	}
+}
+
+// generic path of bernsteinDispatch: the cached Bernstein weights, accumulated in double for both precisions
+template<typename Points, typename T>
+void bernsteinGeneric( const Points & controlPoints, int amountSamples, vector3<T> * result ){
+	bernsteinBasisCache::shared().get( controlPoints.size()-1, amountSamples )->evaluate( controlPoints, result );
+}
+
+// amountSamples+2 uniform samples in [0,1] written to result: bernsteinFixed up to maxFixedDegree, bernsteinGeneric above.
+// result may be in float for double control points (vec3 in, vec3f out)
+template<typename T, typename R>
+void bernsteinDispatch( const std::deque< vector3<T> > & controlPoints, int amountSamples, vector3<R> * result ){
+	switch( (int)controlPoints.size()-1 ){
+		case 1: bernsteinFixed<1>( controlPoints, amountSamples, result ); break;
+		case 2: bernsteinFixed<2>( controlPoints, amountSamples, result ); break;
+		case 3: bernsteinFixed<3>( controlPoints, amountSamples, result ); break;
+		default: bernsteinGeneric( controlPoints, amountSamples, result );
+	}
+}
+
+// same as above on a view, the specialized kernels read the control points in place
+template<typename T, typename R>
+void bernsteinDispatch( const curveViewT<T> & controlPoints, int amountSamples, vector3<R> * result ){
+	switch( controlPoints.size()-1 ){
+		case 1: bernsteinFixed<1>( (const vector3<T> *)controlPoints.data(), amountSamples, result ); break;
+		case 2: bernsteinFixed<2>( (const vector3<T> *)controlPoints.data(), amountSamples, result ); break;
+		case 3: bernsteinFixed<3>( (const vector3<T> *)controlPoints.data(), amountSamples, result ); break;
+		default: bernsteinGeneric( controlPoints, amountSamples, result );
+	}
+}
+
+// calculate the Bezier curve with bernsteinDispatch. amountSamples defines the amount of samples in the curve
+template<typename T>
+std::deque< vector3<T> > bernsteinDispatch( const std::deque< vector3<T> > & controlPoints, int amountSamples ){
+	std::vector< vector3<T> > vertices( amountSamples+2 );
+	bernsteinDispatch( controlPoints, amountSamples, &vertices[0] );
+	return std::deque< vector3<T> >( vertices.begin(), vertices.end() );
+}
@@ -0,0 +1,73 @@
+#include <float.h>
+#include "vec3.h"
+#include "curveView.h"
+
+#pragma once
+
+// Axis-aligned box, empty (inverted) until a point is added. A Bezier curve lies inside the box of its control points
+class boundingBox
+{
+private:
+	vec3 minimum = vec3( DBL_MAX, DBL_MAX, DBL_MAX );
+	vec3 maximum = vec3( -DBL_MAX, -DBL_MAX, -DBL_MAX );
+
+public:
+	constexpr boundingBox() {}
+	constexpr boundingBox( const vec3 & minimum, const vec3 & maximum ) : minimum( minimum ), maximum( maximum ) {}
+
+	// box of the control points
+	static boundingBox of( const vec3 * points, int amount ){
+		boundingBox result;
+		for( int i = 0; i < amount; i++ ){
+			result.extend( points[i] );
+		}
+		return result;
+	}
+	static boundingBox of( const curveView & controlPoints ){ return of( controlPoints.data(), controlPoints.size() ); }
+
+	constexpr const vec3 & getMin() const { return this->minimum; }
+	constexpr const vec3 & getMax() const { return this->maximum; }
+	constexpr bool isEmpty() const { return this->minimum.getX() > this->maximum.getX(); }
+	constexpr vec3 center() const { return ( this->minimum + this->maximum ) * 0.5; }
+	constexpr vec3 extent() const { return this->maximum - this->minimum; }
+
+	// 0, 1 or 2 for x, y or z
+	constexpr int longestAxis() const {
+		vec3 e = this->extent();
+		return e.getX() >= e.getY() && e.getX() >= e.getZ() ? 0 : ( e.getY() >= e.getZ() ? 1 : 2 );
+	}
+
+	constexpr void extend( const vec3 & point ){
+		this->minimum.set( point.getX() < this->minimum.getX() ? point.getX() : this->minimum.getX(),
+		                   point.getY() < this->minimum.getY() ? point.getY() : this->minimum.getY(),
+		                   point.getZ() < this->minimum.getZ() ? point.getZ() : this->minimum.getZ() );
+		this->maximum.set( point.getX() > this->maximum.getX() ? point.getX() : this->maximum.getX(),
+		                   point.getY() > this->maximum.getY() ? point.getY() : this->maximum.getY(),
+		                   point.getZ() > this->maximum.getZ() ? point.getZ() : this->maximum.getZ() );
+	}
+	constexpr void extend( const boundingBox & box ){
+		if( !box.isEmpty() ){
+			this->extend( box.minimum );
+			this->extend( box.maximum );
+		}
+	}
+
+	constexpr bool contains( const vec3 & point ) const {
+		return point.getX() >= this->minimum.getX() && point.getX() <= this->maximum.getX()
+		    && point.getY() >= this->minimum.getY() && point.getY() <= this->maximum.getY()
+		    && point.getZ() >= this->minimum.getZ() && point.getZ() <= this->maximum.getZ();
+	}
+	constexpr bool overlaps( const boundingBox & box ) const {
+		return this->minimum.getX() <= box.maximum.getX() && box.minimum.getX() <= this->maximum.getX()
+		    && this->minimum.getY() <= box.maximum.getY() && box.minimum.getY() <= this->maximum.getY()
+		    && this->minimum.getZ() <= box.maximum.getZ() && box.minimum.getZ() <= this->maximum.getZ();
+	}
+
+	// squared distance from the point to the box, 0 inside
+	constexpr double distanceSquared( const vec3 & point ) const {
+		double dx = point.getX() < this->minimum.getX() ? this->minimum.getX() - point.getX() : ( point.getX() > this->maximum.getX() ? point.getX() - this->maximum.getX() : 0 );
+		double dy = point.getY() < this->minimum.getY() ? this->minimum.getY() - point.getY() : ( point.getY() > this->maximum.getY() ? point.getY() - this->maximum.getY() : 0 );
+		double dz = point.getZ() < this->minimum.getZ() ? this->minimum.getZ() - point.getZ() : ( point.getZ() > this->maximum.getZ() ? point.getZ() - this->maximum.getZ() : 0 );
+		return dx*dx + dy*dy + dz*dz;
+	}
+};
@@ -0,0 +1,111 @@
+#include "casteljau.h"
+
+template<typename T>
+casteljauEvaluatorT<T>::casteljauEvaluatorT() {
+}
+
+template<typename T>
+casteljauEvaluatorT<T>::casteljauEvaluatorT( int degree ) {
+	this->reserve( degree );
+}
+
+// grows the scratch triangle so that curves up to degree do not allocate
+template<typename T>
+void casteljauEvaluatorT<T>::reserve( int degree ) {
+	if( (int)this->triangle.size() < degree+1 ){
+		this->triangle.resize( degree+1 );
+	}
+}
+
+// copies the control points (a deque or a curveView) into the first row of the triangle
+template<typename T>
+template<typename Points>
+void casteljauEvaluatorT<T>::load( const Points & controlPoints ) {
+	this->reserve( controlPoints.size()-1 );
+	for( int i = 0; i < controlPoints.size(); i++ ){
+		this->triangle[i] = controlPoints[i];
+	}
+}
+
+// replaces the current row by the next one ( P(k,i) = (1-u)*P(k-1,i) + u*P(k-1,i+1) ), last being its size
+template<typename T>
+void casteljauEvaluatorT<T>::reduceRow( T u, int last ) {
+	for( int i = 0; i < last; i++ ){
+		vector3<T> & a = this->triangle[i];
+		vector3<T> & b = this->triangle[i+1];
+		a.set( a.getX()*(1-u) + b.getX()*u, a.getY()*(1-u) + b.getY()*u, a.getZ()*(1-u) + b.getZ()*u );
+	}
+}
+
+template<typename T>
+template<typename Points>
+vector3<T> casteljauEvaluatorT<T>::evaluatePoints( T u, const Points & controlPoints ) {
+	int degree = controlPoints.size()-1;
+	this->load( controlPoints );
+	for( int k = 1; k <= degree; k++ ){
+		this->reduceRow( u, degree+1 - k );
+	}
+	return this->triangle[0];
+}
+
+template<typename T>
+vector3<T> casteljauEvaluatorT<T>::evaluate( T u, const std::deque< vector3<T> > & controlPoints ) {
+	return this->evaluatePoints( u, controlPoints );
+}
+
+template<typename T>
+vector3<T> casteljauEvaluatorT<T>::evaluate( T u, const curveViewT<T> & controlPoints ) {
+	return this->evaluatePoints( u, controlPoints );
+}
+
+template<typename T>
+void casteljauEvaluatorT<T>::evaluate( const T * u, int amount, const std::deque< vector3<T> > & controlPoints, vector3<T> * result ) {
+	this->reserve( controlPoints.size()-1 );
+	for( int s = 0; s < amount; s++ ){
+		result[s] = this->evaluatePoints( u[s], controlPoints );
+	}
+}
+
+template<typename T>
+void casteljauEvaluatorT<T>::evaluate( const T * u, int amount, const curveViewT<T> & controlPoints, vector3<T> * result ) {
+	this->reserve( controlPoints.size()-1 );
+	for( int s = 0; s < amount; s++ ){
+		result[s] = this->evaluatePoints( u[s], controlPoints );
+	}
+}
+
+template<typename T>
+void casteljauEvaluatorT<T>::subdivide( T u, const std::deque< vector3<T> > & controlPoints, std::deque< vector3<T> > & left, std::deque< vector3<T> > & right ) {
+	int degree = controlPoints.size()-1;
+	this->load( controlPoints );
+	left.resize( degree+1 );
+	right.resize( degree+1 );
+	// left takes the first point of each row, right the last one
+	left[0] = this->triangle[0];
+	right[degree] = this->triangle[degree];
+	for( int k = 1; k <= degree; k++ ){
+		this->reduceRow( u, degree+1 - k );
+		left[k] = this->triangle[0];
+		right[degree-k] = this->triangle[degree-k];
+	}
+}
+
+template<typename T>
+void casteljauEvaluatorT<T>::subdivide( T u, const vector3<T> * controlPoints, int amount, vector3<T> * left, vector3<T> * right ) {
+	int degree = amount-1;
+	this->reserve( degree );
+	for( int i = 0; i < amount; i++ ){
+		this->triangle[i] = controlPoints[i];
+	}
+	left[0] = this->triangle[0];
+	right[degree] = this->triangle[degree];
+	for( int k = 1; k <= degree; k++ ){
+		this->reduceRow( u, degree+1 - k );
+		left[k] = this->triangle[0];
+		right[degree-k] = this->triangle[degree-k];
+	}
+}
+
+// the two precisions of vector3
+template class casteljauEvaluatorT<double>;
+template class casteljauEvaluatorT<float>;
@@ -0,0 +1,42 @@
+#include <deque>
+#include <vector>
+#include "vec3.h"
+#include "curveView.h"
+
+#pragma once
+
+// de Casteljau evaluator working in a single scratch triangle (O(n^2) per sample, no allocation per sample).
+// Instantiated for vec3 (casteljauEvaluator) and vec3f (casteljauEvaluatorF)
+template<typename T>
+class casteljauEvaluatorT
+{
+private:
+	std::vector< vector3<T> > triangle;	// one row of the de Casteljau triangle, reused between samples
+
+	template<typename Points>
+	void load( const Points & controlPoints );
+	void reduceRow( T u, int last );
+	template<typename Points>
+	vector3<T> evaluatePoints( T u, const Points & controlPoints );
+
+public:
+	casteljauEvaluatorT();
+	casteljauEvaluatorT( int degree );
+
+	void reserve( int degree );
+
+	// position on the Bezier curve related to the factor u [0,1]
+	vector3<T> evaluate( T u, const std::deque< vector3<T> > & controlPoints );
+	vector3<T> evaluate( T u, const curveViewT<T> & controlPoints );
+	// positions for the amount parameters in u, written to result
+	void evaluate( const T * u, int amount, const std::deque< vector3<T> > & controlPoints, vector3<T> * result );
+	void evaluate( const T * u, int amount, const curveViewT<T> & controlPoints, vector3<T> * result );
+
+	// split the curve at u: left covers [0,u] and right covers [u,1], both with the same degree
+	void subdivide( T u, const std::deque< vector3<T> > & controlPoints, std::deque< vector3<T> > & left, std::deque< vector3<T> > & right );
+	// same on arrays of amount points, left and right hold amount points each
+	void subdivide( T u, const vector3<T> * controlPoints, int amount, vector3<T> * left, vector3<T> * right );
+};
+
+typedef casteljauEvaluatorT<double> casteljauEvaluator;
+typedef casteljauEvaluatorT<float> casteljauEvaluatorF;
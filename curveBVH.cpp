@@ -0,0 +1,279 @@
+#include "curveBVH.h"
+#include <algorithm>
+#include "math.h"
+#include "adaptiveTessellation.h"
+
+static double coordinate( const vec3 & point, int axis ){
+	return axis == 0 ? point.getX() : ( axis == 1 ? point.getY() : point.getZ() );
+}
+
+curveBVH::curveBVH( int leafSize, double tolerance, int maxDepth ) {
+	this->leafSize = leafSize < 1 ? 1 : leafSize;
+	this->tolerance = tolerance;
+	this->maxDepth = maxDepth;
+	this->left.resize( maxDepth );
+	this->right.resize( maxDepth );
+}
+
+void curveBVH::build( splineStore & curves ) {
+	this->curves = &curves;
+	int amount = curves.size();
+	this->nodes.clear();
+	this->nodes.reserve( amount > 0 ? 4*amount/this->leafSize + 1 : 0 );
+	this->order.resize( amount );
+	this->leafOfCurve.resize( amount );
+	this->curveBoxes.resize( amount );
+	this->centers.resize( amount );
+	for( int i = 0; i < amount; i++ ){
+		this->order[i] = i;
+		this->curveBoxes[i] = boundingBox::of( curves[i] );
+		this->centers[i] = this->curveBoxes[i].center();
+	}
+	if( amount > 0 ){
+		this->buildNode( 0, amount, -1 );
+	}
+}
+
+int curveBVH::buildNode( int first, int count, int parent ) {
+	int index = this->nodes.size();
+	this->nodes.push_back( node() );
+	boundingBox box, centerBox;
+	for( int i = first; i < first+count; i++ ){
+		box.extend( this->curveBoxes[this->order[i]] );
+		centerBox.extend( this->centers[this->order[i]] );
+	}
+	this->nodes[index].box = box;
+	this->nodes[index].parent = parent;
+	this->nodes[index].left = this->nodes[index].right = -1;
+	this->nodes[index].first = first;
+	this->nodes[index].count = count;
+	if( count <= this->leafSize ){
+		for( int i = first; i < first+count; i++ ){
+			this->leafOfCurve[this->order[i]] = index;
+		}
+		return index;
+	}
+
+	// median of the centers along the longest axis
+	int axis = centerBox.longestAxis();
+	int half = count/2;
+	std::vector<vec3> & centers = this->centers;
+	std::nth_element( this->order.begin()+first, this->order.begin()+first+half, this->order.begin()+first+count, [&]( int a, int b ){
+		return coordinate( centers[a], axis ) < coordinate( centers[b], axis );
+	} );
+	int leftChild = this->buildNode( first, half, index );
+	int rightChild = this->buildNode( first+half, count-half, index );
+	this->nodes[index].left = leftChild;
+	this->nodes[index].right = rightChild;
+	this->nodes[index].count = 0;
+	return index;
+}
+
+void curveBVH::refit( int curve ) {
+	this->curveBoxes[curve] = boundingBox::of( (*this->curves)[curve] );
+	int index = this->leafOfCurve[curve];
+	node & leaf = this->nodes[index];
+	leaf.box = boundingBox();
+	for( int i = leaf.first; i < leaf.first+leaf.count; i++ ){
+		leaf.box.extend( this->curveBoxes[this->order[i]] );
+	}
+	// the ancestors up to the root
+	for( index = leaf.parent; index >= 0; index = this->nodes[index].parent ){
+		node & current = this->nodes[index];
+		current.box = this->nodes[current.left].box;
+		current.box.extend( this->nodes[current.right].box );
+	}
+}
+
+void curveBVH::refitAll() {
+	for( int i = 0; i < this->curveBoxes.size(); i++ ){
+		this->curveBoxes[i] = boundingBox::of( (*this->curves)[i] );
+	}
+	// children are stored after their parent
+	for( int index = this->nodes.size()-1; index >= 0; index-- ){
+		node & current = this->nodes[index];
+		current.box = boundingBox();
+		if( current.left < 0 ){
+			for( int i = current.first; i < current.first+current.count; i++ ){
+				current.box.extend( this->curveBoxes[this->order[i]] );
+			}
+		}
+		else{
+			current.box.extend( this->nodes[current.left].box );
+			current.box.extend( this->nodes[current.right].box );
+		}
+	}
+}
+
+int curveBVH::getAmountNodes() const {
+	return this->nodes.size();
+}
+int curveBVH::getAmountCurves() const {
+	return this->order.size();
+}
+const boundingBox & curveBVH::getBox() const {
+	static const boundingBox empty;
+	return this->nodes.empty() ? empty : this->nodes[0].box;
+}
+
+void curveBVH::setTolerance( double tolerance ) {
+	this->tolerance = tolerance;
+}
+double curveBVH::getTolerance() const {
+	return this->tolerance;
+}
+
+// closest point of the piece [u0,u1] of the curve, when its control polygon can still be closer than best
+void curveBVH::refine( int curve, const vec3 * points, int amount, double u0, double u1, int depth, const vec3 & point, curveHit & best ) {
+	if( boundingBox::of( points, amount ).distanceSquared( point ) > best.distance*best.distance ){
+		return;
+	}
+	if( amount == 1 || depth >= this->maxDepth || flatness( points, amount ) <= this->tolerance ){
+		// the piece is its chord within the tolerance
+		vec3 a = points[0], ab = points[amount-1] - points[0];
+		double length = ab.normeCarre();
+		double t = length > 0 ? ( point - a ).produitScalaire( ab )/length : 0;
+		t = t < 0 ? 0 : ( t > 1 ? 1 : t );
+		vec3 candidate = a + ab*t;
+		double distance = ( point - candidate ).norme();
+		if( distance < best.distance ){
+			best.curve = curve;
+			best.u = u0 + (u1-u0)*t;
+			best.point = candidate;
+			best.distance = distance;
+		}
+		return;
+	}
+
+	std::vector<vec3> & leftHalf = this->left[depth];
+	std::vector<vec3> & rightHalf = this->right[depth];
+	leftHalf.resize( amount );
+	rightHalf.resize( amount );
+	this->evaluator.subdivide( 0.5, points, amount, &leftHalf[0], &rightHalf[0] );
+	double middle = (u0+u1)/2;
+	// nearer half first, the other one is often skipped
+	if( boundingBox::of( &leftHalf[0], amount ).distanceSquared( point ) <= boundingBox::of( &rightHalf[0], amount ).distanceSquared( point ) ){
+		this->refine( curve, &leftHalf[0], amount, u0, middle, depth+1, point, best );
+		this->refine( curve, &rightHalf[0], amount, middle, u1, depth+1, point, best );
+	}
+	else{
+		this->refine( curve, &rightHalf[0], amount, middle, u1, depth+1, point, best );
+		this->refine( curve, &leftHalf[0], amount, u0, middle, depth+1, point, best );
+	}
+}
+
+curveHit curveBVH::nearestPoint( const vec3 & point, double maxDistance ) {
+	curveHit best;
+	best.distance = maxDistance;
+	if( this->nodes.empty() ){
+		return best;
+	}
+	this->stack.clear();
+	this->stack.push_back( 0 );
+	while( !this->stack.empty() ){
+		const node & current = this->nodes[this->stack.back()];
+		this->stack.pop_back();
+		if( current.box.distanceSquared( point ) > best.distance*best.distance ){
+			continue;
+		}
+		if( current.left < 0 ){
+			for( int i = current.first; i < current.first+current.count; i++ ){
+				int curve = this->order[i];
+				if( this->curveBoxes[curve].distanceSquared( point ) <= best.distance*best.distance ){
+					curveView controlPoints = (*this->curves)[curve];
+					this->refine( curve, controlPoints.data(), controlPoints.size(), 0, 1, 0, point, best );
+				}
+			}
+			continue;
+		}
+		// the nearer child is popped first
+		double leftDistance = this->nodes[current.left].box.distanceSquared( point );
+		double rightDistance = this->nodes[current.right].box.distanceSquared( point );
+		int nearer = leftDistance <= rightDistance ? current.left : current.right;
+		int farther = leftDistance <= rightDistance ? current.right : current.left;
+		this->stack.push_back( farther );
+		this->stack.push_back( nearer );
+	}
+	return best;
+}
+
+curveHit curveBVH::pickControlPoint( const vec3 & point, double radius ) {
+	curveHit best;
+	best.distance = radius;
+	if( this->nodes.empty() ){
+		return best;
+	}
+	this->stack.clear();
+	this->stack.push_back( 0 );
+	while( !this->stack.empty() ){
+		const node & current = this->nodes[this->stack.back()];
+		this->stack.pop_back();
+		if( current.box.distanceSquared( point ) > best.distance*best.distance ){
+			continue;
+		}
+		if( current.left < 0 ){
+			for( int i = current.first; i < current.first+current.count; i++ ){
+				curveView controlPoints = (*this->curves)[this->order[i]];
+				for( int j = 0; j < controlPoints.size(); j++ ){
+					double distance = ( controlPoints[j] - point ).norme();
+					if( distance < best.distance ){
+						best.curve = this->order[i];
+						best.controlPoint = j;
+						best.point = controlPoints[j];
+						best.distance = distance;
+					}
+				}
+			}
+			continue;
+		}
+		this->stack.push_back( current.left );
+		this->stack.push_back( current.right );
+	}
+	return best;
+}
+
+curveHit curveBVH::pickCurve( const vec3 & point, double radius ) {
+	return this->nearestPoint( point, radius );
+}
+
+// pairs of distinct curves of the nodes a and b (a == b for the pairs inside one node) whose boxes overlap
+void curveBVH::collectPairs( int a, int b, std::vector< std::pair<int,int> > & pairs ) const {
+	const node & first = this->nodes[a];
+	const node & second = this->nodes[b];
+	if( !first.box.overlaps( second.box ) ){
+		return;
+	}
+	if( first.left < 0 && second.left < 0 ){
+		for( int i = first.first; i < first.first+first.count; i++ ){
+			int j = a == b ? i+1 : second.first;
+			for( ; j < second.first+second.count; j++ ){
+				int curveA = this->order[i], curveB = this->order[j];
+				if( this->curveBoxes[curveA].overlaps( this->curveBoxes[curveB] ) ){
+					pairs.push_back( curveA < curveB ? std::make_pair( curveA, curveB ) : std::make_pair( curveB, curveA ) );
+				}
+			}
+		}
+		return;
+	}
+	if( a == b ){
+		this->collectPairs( first.left, first.left, pairs );
+		this->collectPairs( first.right, first.right, pairs );
+		this->collectPairs( first.left, first.right, pairs );
+	}
+	else if( second.left < 0 || ( first.left >= 0 && first.box.extent().normeCarre() >= second.box.extent().normeCarre() ) ){
+		// descend the larger node (a leaf is never descended)
+		this->collectPairs( first.left, b, pairs );
+		this->collectPairs( first.right, b, pairs );
+	}
+	else{
+		this->collectPairs( a, second.left, pairs );
+		this->collectPairs( a, second.right, pairs );
+	}
+}
+
+void curveBVH::overlappingPairs( std::vector< std::pair<int,int> > & pairs ) const {
+	pairs.clear();
+	if( !this->nodes.empty() ){
+		this->collectPairs( 0, 0, pairs );
+	}
+}
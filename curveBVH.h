@@ -0,0 +1,87 @@
+#include <vector>
+#include <utility>
+#include <float.h>
+#include "vec3.h"
+#include "curveView.h"
+#include "casteljau.h"
+#include "splineStore.h"
+#include "boundingBox.h"
+
+#pragma once
+
+// Result of a query on curveBVH: curve -1 when nothing was found within the distance
+struct curveHit
+{
+	int curve = -1;
+	int controlPoint = -1;		// pickControlPoint only
+	double u = 0;			// parameter of point on the curve (nearestPoint and pickCurve)
+	vec3 point;			// on the curve within the tolerance of curveBVH, or the control point
+	double distance = DBL_MAX;
+
+	bool isFound() const { return this->curve >= 0; }
+};
+
+/**
+ *	Bounding volume hierarchy over the curves of a splineStore, for picking and closest point queries.
+ * Each curve is bounded by the box of its control points (convex hull property), the nodes are split
+ * at the median of the longest axis down to leafSize curves. When control points move, refit() grows or
+ * shrinks the boxes from the leaf of the curve to the root without rebuilding the tree.
+ * nearestPoint() visits the nodes nearest first, skips those farther than the best distance found so far,
+ * and only subdivides (de Casteljau at 0.5) the curves of the leaves it reaches, until the pieces are flat
+ * within the tolerance.
+ * The queries reuse scratch buffers: one curveBVH per thread.
+ *
+ */
+class curveBVH
+{
+private:
+	struct node
+	{
+		boundingBox box;
+		int parent;
+		int left, right;	// children, -1 for a leaf
+		int first, count;	// curves order[first .. first+count) of a leaf
+	};
+
+	splineStore * curves = NULL;
+	std::vector<node> nodes;		// nodes[0] the root, parents before their children
+	std::vector<int> order;			// curves sorted by leaf
+	std::vector<int> leafOfCurve;
+	std::vector<boundingBox> curveBoxes;	// box of the control points of each curve
+	std::vector<vec3> centers;		// of the curve boxes, used while building
+	std::vector<int> stack;
+	std::vector< std::vector<vec3> > left, right;	// halves of each depth of the refinement
+	casteljauEvaluator evaluator;
+	int leafSize;
+	int maxDepth;
+	double tolerance;
+
+	int buildNode( int first, int count, int parent );
+	void collectPairs( int a, int b, std::vector< std::pair<int,int> > & pairs ) const;
+	void refine( int curve, const vec3 * points, int amount, double u0, double u1, int depth, const vec3 & point, curveHit & best );
+
+public:
+	curveBVH( int leafSize = 4, double tolerance = 1e-9, int maxDepth = 40 );
+
+	void build( splineStore & curves );
+	// to be called when control points of the curve moved
+	void refit( int curve );
+	void refitAll();
+
+	int getAmountNodes() const;
+	int getAmountCurves() const;
+	const boundingBox & getBox() const;
+
+	void setTolerance( double tolerance );
+	double getTolerance() const;
+
+	// closest point on any curve, within maxDistance
+	curveHit nearestPoint( const vec3 & point, double maxDistance = DBL_MAX );
+	// closest control point within radius
+	curveHit pickControlPoint( const vec3 & point, double radius );
+	// closest curve within radius
+	curveHit pickCurve( const vec3 & point, double radius );
+
+	// pairs (a < b) of curves whose boxes overlap, the broad phase of the curve-curve intersections
+	void overlappingPairs( std::vector< std::pair<int,int> > & pairs ) const;
+};
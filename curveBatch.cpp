@@ -0,0 +1,154 @@
+#include "curveBatch.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CURVEBATCH_X86
+#include <immintrin.h>
+#endif
+
+simdLevel detectSimdLevel(){
+#ifdef CURVEBATCH_X86
+	__builtin_cpu_init();
+	if( __builtin_cpu_supports( "avx2" ) ){
+		return SIMD_AVX2;
+	}
+	if( __builtin_cpu_supports( "sse2" ) ){
+		return SIMD_SSE2;
+	}
+#endif
+	return SIMD_SCALAR;
+}
+
+const char * simdLevelName( simdLevel level ){
+	switch( level ){
+	case SIMD_AVX2:
+		return "avx2";
+	case SIMD_SSE2:
+		return "sse2";
+	default:
+		return "scalar";
+	}
+}
+
+// out[s] = w0*P0[s] + w1*P1[s] + w2*P2[s] + w3*P3[s] for s in [begin,end)
+static void combineScalar( const double * const * p, const double * w, int begin, int end, double * out ){
+	for( int s = begin; s < end; s++ ){
+		out[s] = w[0]*p[0][s] + w[1]*p[1][s] + w[2]*p[2][s] + w[3]*p[3][s];
+	}
+}
+
+#ifdef CURVEBATCH_X86
+__attribute__((target("sse2")))
+static void combineSse2( const double * const * p, const double * w, int count, double * out ){
+	__m128d w0 = _mm_set1_pd( w[0] ), w1 = _mm_set1_pd( w[1] ), w2 = _mm_set1_pd( w[2] ), w3 = _mm_set1_pd( w[3] );
+	int s = 0;
+	for( ; s+2 <= count; s += 2 ){
+		__m128d r = _mm_mul_pd( w0, _mm_loadu_pd( p[0]+s ) );
+		r = _mm_add_pd( r, _mm_mul_pd( w1, _mm_loadu_pd( p[1]+s ) ) );
+		r = _mm_add_pd( r, _mm_mul_pd( w2, _mm_loadu_pd( p[2]+s ) ) );
+		r = _mm_add_pd( r, _mm_mul_pd( w3, _mm_loadu_pd( p[3]+s ) ) );
+		_mm_storeu_pd( out+s, r );
+	}
+	combineScalar( p, w, s, count, out );
+}
+
+// no FMA on purpose: the sums are rounded as in the scalar kernel
+__attribute__((target("avx2")))
+static void combineAvx2( const double * const * p, const double * w, int count, double * out ){
+	__m256d w0 = _mm256_set1_pd( w[0] ), w1 = _mm256_set1_pd( w[1] ), w2 = _mm256_set1_pd( w[2] ), w3 = _mm256_set1_pd( w[3] );
+	int s = 0;
+	for( ; s+4 <= count; s += 4 ){
+		__m256d r = _mm256_mul_pd( w0, _mm256_loadu_pd( p[0]+s ) );
+		r = _mm256_add_pd( r, _mm256_mul_pd( w1, _mm256_loadu_pd( p[1]+s ) ) );
+		r = _mm256_add_pd( r, _mm256_mul_pd( w2, _mm256_loadu_pd( p[2]+s ) ) );
+		r = _mm256_add_pd( r, _mm256_mul_pd( w3, _mm256_loadu_pd( p[3]+s ) ) );
+		_mm256_storeu_pd( out+s, r );
+	}
+	combineScalar( p, w, s, count, out );
+}
+#endif
+
+cubicBatch::cubicBatch() {
+	this->level = detectSimdLevel();
+}
+
+void cubicBatch::reserve( int amountSegments ) {
+	for( int i = 0; i < 4; i++ ){
+		for( int c = 0; c < 3; c++ ){
+			this->coordinates[i][c].reserve( amountSegments );
+		}
+	}
+}
+
+void cubicBatch::clear() {
+	for( int i = 0; i < 4; i++ ){
+		for( int c = 0; c < 3; c++ ){
+			this->coordinates[i][c].clear();
+		}
+	}
+}
+
+int cubicBatch::size() const {
+	return this->coordinates[0][0].size();
+}
+
+int cubicBatch::addBezier( vec3 p0, vec3 p1, vec3 p2, vec3 p3 ) {
+	vec3 points[4] = { p0, p1, p2, p3 };
+	for( int i = 0; i < 4; i++ ){
+		this->coordinates[i][0].push_back( points[i].getX() );
+		this->coordinates[i][1].push_back( points[i].getY() );
+		this->coordinates[i][2].push_back( points[i].getZ() );
+	}
+	return this->size()-1;
+}
+
+int cubicBatch::addBezier( std::deque<vec3> & controlPoints ) {
+	return this->addBezier( controlPoints[0], controlPoints[1], controlPoints[2], controlPoints[3] );
+}
+
+int cubicBatch::addHermite( vec3 p1, vec3 p2, vec3 v1, vec3 v2 ) {
+	return this->addBezier( p1, p1.addition( v1.division( 3 ) ), p2.soustraction( v2.division( 3 ) ), p2 );
+}
+
+vec3 cubicBatch::getControlPoint( int segment, int i ) const {
+	return vec3( this->coordinates[i][0][segment], this->coordinates[i][1][segment], this->coordinates[i][2][segment] );
+}
+
+simdLevel cubicBatch::getLevel() const {
+	return this->level;
+}
+
+void cubicBatch::setLevel( simdLevel level ) {
+	simdLevel supported = detectSimdLevel();
+	this->level = level > supported ? supported : level;
+}
+
+void cubicBatch::evaluate( double u, double * x, double * y, double * z ) const {
+	// Bernstein weights, shared by every segment
+	double w[4] = { (1-u)*(1-u)*(1-u), 3*u*(1-u)*(1-u), 3*u*u*(1-u), u*u*u };
+	double * out[3] = { x, y, z };
+	int count = this->size();
+	for( int c = 0; c < 3; c++ ){
+		const double * p[4] = { this->coordinates[0][c].data(), this->coordinates[1][c].data(), this->coordinates[2][c].data(), this->coordinates[3][c].data() };
+		switch( this->level ){
+#ifdef CURVEBATCH_X86
+		case SIMD_AVX2:
+			combineAvx2( p, w, count, out[c] );
+			break;
+		case SIMD_SSE2:
+			combineSse2( p, w, count, out[c] );
+			break;
+#endif
+		default:
+			combineScalar( p, w, 0, count, out[c] );
+			break;
+		}
+	}
+}
+
+void cubicBatch::tessellate( int amountSamples, double * x, double * y, double * z ) const {
+	int amount = amountSamples+2;   // at least 2 samples will be created
+	int count = this->size();
+	for( int i = 0; i < amount; i++ ){
+		this->evaluate( i/((double)amount-1), x + i*count, y + i*count, z + i*count );
+	}
+}
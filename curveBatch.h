@@ -0,0 +1,47 @@
+#include <deque>
+#include <vector>
+#include "vec3.h"
+
+#pragma once
+
+// instruction sets of the batch kernels, the best one supported by the CPU is selected at runtime
+enum simdLevel { SIMD_SCALAR = 0, SIMD_SSE2 = 1, SIMD_AVX2 = 2 };
+
+simdLevel detectSimdLevel();
+const char * simdLevelName( simdLevel level );
+
+/**
+ *	Structure-of-arrays batch of cubic Bezier segments.
+ * Each coordinate of each control point is stored in its own contiguous array, so the kernels
+ * evaluate 2 (SSE2) or 4 (AVX2) segments per instruction. Hermite segments are stored with their
+ * Bezier control points ( P1, P1 + V1/3, P2 - V2/3, P2 ), which is the same cubic as hermite().
+ * Every level performs the same operations in the same order: the results are identical.
+ *
+ */
+class cubicBatch
+{
+private:
+	std::vector<double> coordinates[4][3];	// [control point][x,y,z][segment]
+	simdLevel level;
+
+public:
+	cubicBatch();
+
+	void reserve( int amountSegments );
+	void clear();
+	int size() const;
+
+	int addBezier( vec3 p0, vec3 p1, vec3 p2, vec3 p3 );
+	int addBezier( std::deque<vec3> & controlPoints );
+	int addHermite( vec3 p1, vec3 p2, vec3 v1, vec3 v2 );
+	vec3 getControlPoint( int segment, int i ) const;
+
+	simdLevel getLevel() const;
+	// forces a level (clamped to what the CPU supports)
+	void setLevel( simdLevel level );
+
+	// positions of every segment at u, x[segment]
+	void evaluate( double u, double * x, double * y, double * z ) const;
+	// amountSamples+2 uniform samples per segment, sample-major: x[sample*size() + segment]
+	void tessellate( int amountSamples, double * x, double * y, double * z ) const;
+};
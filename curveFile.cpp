@@ -0,0 +1,260 @@
+#include "curveFile.h"
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+curveFileReader::~curveFileReader() {
+	this->close();
+}
+
+#ifdef _WIN32
+bool curveFileReader::map( const char * path ) {
+	HANDLE file = CreateFileA( path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+	if( file == INVALID_HANDLE_VALUE ){
+		return false;
+	}
+	this->file = file;
+	LARGE_INTEGER size;
+	if( !GetFileSizeEx( file, &size ) || size.QuadPart == 0 ){
+		return false;
+	}
+	this->length = size.QuadPart;
+	this->fileMapping = CreateFileMappingA( file, NULL, PAGE_WRITECOPY, 0, 0, NULL );
+	if( this->fileMapping == NULL ){
+		return false;
+	}
+	this->mapping = (char *)MapViewOfFile( this->fileMapping, FILE_MAP_COPY, 0, 0, 0 );
+	return this->mapping != NULL;
+}
+
+void curveFileReader::unmap() {
+	if( this->mapping != NULL ){
+		UnmapViewOfFile( this->mapping );
+	}
+	if( this->fileMapping != NULL ){
+		CloseHandle( this->fileMapping );
+	}
+	if( this->file != NULL ){
+		CloseHandle( this->file );
+	}
+	this->file = this->fileMapping = NULL;
+}
+#else
+bool curveFileReader::map( const char * path ) {
+	int file = ::open( path, O_RDONLY );
+	if( file < 0 ){
+		return false;
+	}
+	struct stat status;
+	if( fstat( file, &status ) != 0 || status.st_size == 0 ){
+		::close( file );
+		return false;
+	}
+	this->length = status.st_size;
+	// the mapping keeps the file alive after the descriptor is closed
+	void * mapping = mmap( NULL, this->length, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0 );
+	::close( file );
+	if( mapping == MAP_FAILED ){
+		return false;
+	}
+	this->mapping = (char *)mapping;
+	return true;
+}
+
+void curveFileReader::unmap() {
+	if( this->mapping != NULL ){
+		munmap( this->mapping, this->length );
+	}
+}
+#endif
+
+// the sections are inside the file, aligned, and the offsets increase up to amountPoints
+bool curveFileReader::validate() {
+	if( this->length < sizeof(curveFileHeader) ){
+		return false;
+	}
+	const curveFileHeader * header = (const curveFileHeader *)this->mapping;
+	if( memcmp( header->magic, curveFileMagic, 4 ) != 0 || header->version != curveFileVersion ){
+		return false;
+	}
+	uint64_t amountCurves = header->amountCurves, amountPoints = header->amountPoints;
+	if( amountCurves >= INT32_MAX || amountPoints > this->length/sizeof(vec3)
+	 || header->coordinatesOffset % 8 != 0 || header->recordsOffset % 8 != 0 || header->offsetsOffset % 8 != 0
+	 || header->coordinatesOffset > this->length || amountPoints*sizeof(vec3) > this->length - header->coordinatesOffset
+	 || header->recordsOffset > this->length || amountCurves*sizeof(curveRecord) > this->length - header->recordsOffset
+	 || header->offsetsOffset > this->length || (amountCurves+1)*sizeof(uint64_t) > this->length - header->offsetsOffset ){
+		return false;
+	}
+	const uint64_t * offsets = (const uint64_t *)( this->mapping + header->offsetsOffset );
+	if( offsets[0] != 0 || offsets[amountCurves] != amountPoints ){
+		return false;
+	}
+	for( uint64_t i = 0; i < amountCurves; i++ ){
+		// every curve has at least 2 points (the evaluators and tessellators index the degree)
+		if( offsets[i+1] < offsets[i]+2 || offsets[i+1] - offsets[i] > INT32_MAX ){
+			return false;
+		}
+	}
+	this->header = header;
+	this->points = (vec3 *)( this->mapping + header->coordinatesOffset );
+	this->records = (const curveRecord *)( this->mapping + header->recordsOffset );
+	this->offsets = offsets;
+	return true;
+}
+
+bool curveFileReader::open( const char * path ) {
+	this->close();
+	if( !this->map( path ) || !this->validate() ){
+		this->close();
+		return false;
+	}
+	return true;
+}
+
+void curveFileReader::close() {
+	this->unmap();
+	this->mapping = NULL;
+	this->length = 0;
+	this->header = NULL;
+	this->points = NULL;
+	this->records = NULL;
+	this->offsets = NULL;
+}
+
+bool curveFileReader::isOpen() const {
+	return this->header != NULL;
+}
+
+int curveFileReader::size() const {
+	return this->header == NULL ? 0 : this->header->amountCurves;
+}
+
+long long curveFileReader::getAmountPoints() const {
+	return this->header == NULL ? 0 : this->header->amountPoints;
+}
+
+int curveFileReader::getDegree( int curve ) const {
+	return this->records[curve].degree;
+}
+
+int curveFileReader::getFlags( int curve ) const {
+	return this->records[curve].flags;
+}
+
+bool curveFileReader::isClosed( int curve ) const {
+	return ( this->records[curve].flags & curveClosed ) != 0;
+}
+
+curveView curveFileReader::getCurve( int curve ) const {
+	uint64_t begin = this->offsets[curve];
+	return curveView( this->points + begin, this->offsets[curve+1] - begin );
+}
+
+curveView curveFileReader::operator[]( int curve ) const {
+	return this->getCurve( curve );
+}
+
+void curveFileReader::copyTo( splineStore & store ) const {
+	store.reserve( store.size() + this->size(), store.getAmountPoints() + this->getAmountPoints() );
+	for( int i = 0; i < this->size(); i++ ){
+		curveView curve = this->getCurve( i );
+		store.addCurve( curve.data(), curve.size() );
+	}
+}
+
+void curveFileReader::viewIn( splineStore & store ) const {
+	store.reserve( store.size() + this->size(), 0 );
+	for( int i = 0; i < this->size(); i++ ){
+		store.addView( this->getCurve( i ) );
+	}
+}
+
+curveFileWriter::~curveFileWriter() {
+	this->close();
+}
+
+void curveFileWriter::write( const void * data, size_t size ) {
+	if( !this->isFailed && size > 0 && fwrite( data, 1, size, this->file ) != size ){
+		this->isFailed = true;
+	}
+}
+
+bool curveFileWriter::open( const char * path ) {
+	this->close();
+	this->file = fopen( path, "wb" );
+	if( this->file == NULL ){
+		return false;
+	}
+	this->isFailed = false;
+	this->records.clear();
+	this->offsets.assign( 1, 0 );
+	// the header is written again by close(), once the sizes are known
+	curveFileHeader header = {};
+	this->write( &header, sizeof(header) );
+	return !this->isFailed;
+}
+
+int curveFileWriter::addCurve( const vec3 * points, int amount, int flags ) {
+	if( amount < 2 ){
+		// not a curve: the reader would reject the file, close() reports the failure
+		this->isFailed = true;
+		return -1;
+	}
+	this->write( points, amount*sizeof(vec3) );
+	curveRecord record = { (uint32_t)( ( flags & curvePolyline ) != 0 ? 1 : amount-1 ), (uint32_t)flags };
+	this->records.push_back( record );
+	this->offsets.push_back( this->offsets.back() + amount );
+	return this->records.size()-1;
+}
+
+int curveFileWriter::addCurve( const curveView & points, int flags ) {
+	return this->addCurve( points.data(), points.size(), flags );
+}
+
+void curveFileWriter::addCurves( const vec3 * vertices, const int * offsets, int amountCurves, int flags ) {
+	for( int i = 0; i < amountCurves; i++ ){
+		this->addCurve( vertices + offsets[i], offsets[i+1] - offsets[i], flags );
+	}
+}
+
+bool curveFileWriter::close() {
+	if( this->file == NULL ){
+		return false;
+	}
+	curveFileHeader header;
+	memcpy( header.magic, curveFileMagic, 4 );
+	header.version = curveFileVersion;
+	header.amountCurves = this->records.size();
+	header.amountPoints = this->offsets.back();
+	header.coordinatesOffset = sizeof(curveFileHeader);
+	header.recordsOffset = header.coordinatesOffset + header.amountPoints*sizeof(vec3);
+	header.offsetsOffset = header.recordsOffset + header.amountCurves*sizeof(curveRecord);
+	this->write( this->records.data(), this->records.size()*sizeof(curveRecord) );
+	this->write( this->offsets.data(), this->offsets.size()*sizeof(uint64_t) );
+	if( !this->isFailed && fseek( this->file, 0, SEEK_SET ) != 0 ){
+		this->isFailed = true;
+	}
+	this->write( &header, sizeof(header) );
+	bool isWritten = fclose( this->file ) == 0 && !this->isFailed;
+	this->file = NULL;
+	this->records.clear();
+	this->offsets.clear();
+	return isWritten;
+}
+
+bool writeCurveFile( splineStore & curves, const char * path ){
+	curveFileWriter writer;
+	if( !writer.open( path ) ){
+		return false;
+	}
+	for( int i = 0; i < curves.size(); i++ ){
+		writer.addCurve( curves[i] );
+	}
+	return writer.close();
+}
@@ -0,0 +1,139 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+#include "vec3.h"
+#include "curveView.h"
+#include "splineStore.h"
+
+#pragma once
+
+/*
+ * Binary file of curves (native byte order, little endian on the supported platforms):
+ *   curveFileHeader
+ *   double coordinates[3*amountPoints]      x y z of each control point, as an array of vec3
+ *   curveRecord records[amountCurves]       degree and flags of each curve
+ *   uint64_t offsets[amountCurves+1]         first control point of each curve, offsets[amountCurves] = amountPoints
+ * Every curve has at least 2 points, the reader rejects files with shorter curves.
+ * The sections are found through the byte offsets of the header and are 8-byte aligned. The tables come
+ * after the coordinates so that a writer streams the points without knowing the amount of curves up front.
+ */
+
+const char curveFileMagic[4] = { 'M', 'C', 'R', 'V' };
+const uint32_t curveFileVersion = 1;
+
+enum curveFlags
+{
+	curveClosed = 1,	// the last point joins the first one
+	curvePolyline = 2	// tessellated vertices instead of Bezier control points
+};
+
+struct curveFileHeader
+{
+	char magic[4];
+	uint32_t version;
+	uint64_t amountCurves;
+	uint64_t amountPoints;
+	uint64_t coordinatesOffset;	// bytes from the start of the file
+	uint64_t recordsOffset;
+	uint64_t offsetsOffset;
+};
+
+struct curveRecord
+{
+	uint32_t degree;	// amount of points - 1 (1 for a polyline)
+	uint32_t flags;		// curveFlags
+};
+
+static_assert( sizeof(vec3) == 3*sizeof(double), "the coordinates of the file are read as vec3" );
+static_assert( sizeof(curveFileHeader) == 48 && sizeof(curveRecord) == 8, "the file layout has no padding" );
+
+/**
+ *	Read-only access to a curve file mapped in memory: nothing is parsed or copied, the curveViews point
+ * into the mapping and go to the evaluators as they are. The pages are loaded by the system when a curve
+ * is read, so opening a large scene costs the same as opening a small one.
+ * The mapping is private (copy-on-write): moving a control point through a view changes the memory of
+ * this process, never the file. The views are valid until close().
+ *
+ */
+class curveFileReader
+{
+private:
+	char * mapping = NULL;
+	uint64_t length = 0;
+#ifdef _WIN32
+	void * file = NULL;
+	void * fileMapping = NULL;
+#endif
+	const curveFileHeader * header = NULL;
+	vec3 * points = NULL;
+	const curveRecord * records = NULL;
+	const uint64_t * offsets = NULL;
+
+	bool map( const char * path );
+	void unmap();
+	bool validate();
+
+	curveFileReader( const curveFileReader & ) = delete;
+	curveFileReader & operator=( const curveFileReader & ) = delete;
+
+public:
+	curveFileReader() {}
+	~curveFileReader();
+
+	// false if the file can not be mapped or is not a valid curve file (the reader is then closed)
+	bool open( const char * path );
+	void close();
+	bool isOpen() const;
+
+	// amount of curves
+	int size() const;
+	long long getAmountPoints() const;
+	int getDegree( int curve ) const;
+	int getFlags( int curve ) const;
+	bool isClosed( int curve ) const;
+
+	curveView getCurve( int curve ) const;
+	curveView operator[]( int curve ) const;
+
+	// copy of every curve, for the code that edits or adds curves
+	void copyTo( splineStore & store ) const;
+	// views of every curve: the store reads the mapping, an edit copies only the pages it writes (the file is
+	// not changed), the reader must stay open while the store is used
+	void viewIn( splineStore & store ) const;
+};
+
+/**
+ *	Writes a curve file curve by curve: the points go to the file as they are added, only the 16 bytes of
+ * the record and offset of each curve are kept until close() writes the tables and the header.
+ * Used for the control points of a scene as well as for tessellated output (curvePolyline).
+ *
+ */
+class curveFileWriter
+{
+private:
+	FILE * file = NULL;
+	bool isFailed = false;
+	std::vector<curveRecord> records;
+	std::vector<uint64_t> offsets;
+
+	void write( const void * data, size_t size );
+
+	curveFileWriter( const curveFileWriter & ) = delete;
+	curveFileWriter & operator=( const curveFileWriter & ) = delete;
+
+public:
+	curveFileWriter() {}
+	~curveFileWriter();
+
+	bool open( const char * path );
+	// appends a curve and returns its index. A curve of fewer than 2 points is refused: -1, and close() returns false
+	int addCurve( const vec3 * points, int amount, int flags = 0 );
+	int addCurve( const curveView & points, int flags = 0 );
+	// the amountCurves curves of a tessellation: curve i is vertices[offsets[i] .. offsets[i+1])
+	void addCurves( const vec3 * vertices, const int * offsets, int amountCurves, int flags = curvePolyline );
+	// writes the tables and the header, false if any write failed
+	bool close();
+};
+
+// control points of every curve of the store, false if the file can not be written
+bool writeCurveFile( splineStore & curves, const char * path );
@@ -0,0 +1,204 @@
+#include "curveIntersection.h"
+#include <algorithm>
+#include "math.h"
+#include "adaptiveTessellation.h"
+#include "boundingBox.h"
+
+double curveIntersector::mergeDistance = 1e-7;
+int curveIntersector::newtonSteps = 8;
+
+static double clampParameter( double t ){
+	return t < 0 ? 0 : ( t > 1 ? 1 : t );
+}
+
+// closest points P0 + s*(P1-P0) and Q0 + t*(Q1-Q0) of the segments, returns their distance
+static double closestOnSegments( const vec3 & p0, const vec3 & p1, const vec3 & q0, const vec3 & q1, double & s, double & t ){
+	vec3 d1 = p1 - p0, d2 = q1 - q0, r = p0 - q0;
+	double a = d1.normeCarre(), e = d2.normeCarre(), f = d2.produitScalaire( r );
+	if( a <= DBL_MIN && e <= DBL_MIN ){
+		s = t = 0;
+	}
+	else if( a <= DBL_MIN ){
+		s = 0;
+		t = clampParameter( f/e );
+	}
+	else{
+		double c = d1.produitScalaire( r );
+		if( e <= DBL_MIN ){
+			t = 0;
+			s = clampParameter( -c/a );
+		}
+		else{
+			double b = d1.produitScalaire( d2 );
+			double denominator = a*e - b*b;
+			s = denominator > 0 ? clampParameter( (b*f - c*e)/denominator ) : 0;
+			t = (b*s + f)/e;
+			if( t < 0 ){
+				t = 0;
+				s = clampParameter( -c/a );
+			}
+			else if( t > 1 ){
+				t = 1;
+				s = clampParameter( (b-c)/a );
+			}
+		}
+	}
+	return ( p0 + d1*s - ( q0 + d2*t ) ).norme();
+}
+
+// derivative of the curve: n*(P(i+1)-Pi), a single null vector for a point
+static void hodographOf( const curveView & controlPoints, std::vector<vec3> & hodograph ){
+	int n = controlPoints.size()-1;
+	hodograph.assign( n > 0 ? n : 1, vec3() );
+	for( int i = 0; i < n; i++ ){
+		hodograph[i] = ( controlPoints[i+1] - controlPoints[i] ) * (double)n;
+	}
+}
+
+curveIntersector::curveIntersector( double tolerance, int maxDepth ) {
+	this->tolerance = tolerance;
+	this->maxDepth = maxDepth;
+	this->leftA.resize( maxDepth );
+	this->rightA.resize( maxDepth );
+	this->leftB.resize( maxDepth );
+	this->rightB.resize( maxDepth );
+}
+
+void curveIntersector::setTolerance( double tolerance ) {
+	this->tolerance = tolerance;
+}
+double curveIntersector::getTolerance() const {
+	return this->tolerance;
+}
+
+// pieces a ( [a0,a1] of the first curve ) and b ( [b0,b1] of the second one )
+void curveIntersector::intersectPieces( const vec3 * a, double a0, double a1, const vec3 * b, double b0, double b1, int depth ) {
+	boundingBox boxA = boundingBox::of( a, this->amountA ), boxB = boundingBox::of( b, this->amountB );
+	if( !boxA.overlaps( boxB ) ){
+		return;
+	}
+	bool isFlatA = flatness( a, this->amountA ) <= this->tolerance;
+	bool isFlatB = flatness( b, this->amountB ) <= this->tolerance;
+	if( ( isFlatA && isFlatB ) || depth >= this->maxDepth ){
+		// both pieces are their chords within the tolerance
+		double s, t;
+		if( closestOnSegments( a[0], a[this->amountA-1], b[0], b[this->amountB-1], s, t ) <= 3*this->tolerance ){
+			this->candidates.push_back( std::make_pair( a0 + (a1-a0)*s, b0 + (b1-b0)*t ) );
+		}
+		return;
+	}
+
+	// split the larger piece that is not flat yet
+	bool isSplitA = !isFlatA && ( isFlatB || boxA.extent().normeCarre() >= boxB.extent().normeCarre() );
+	if( isSplitA ){
+		std::vector<vec3> & left = this->leftA[depth];
+		std::vector<vec3> & right = this->rightA[depth];
+		left.resize( this->amountA );
+		right.resize( this->amountA );
+		this->evaluator.subdivide( 0.5, a, this->amountA, &left[0], &right[0] );
+		double middle = (a0+a1)/2;
+		this->intersectPieces( &left[0], a0, middle, b, b0, b1, depth+1 );
+		this->intersectPieces( &right[0], middle, a1, b, b0, b1, depth+1 );
+	}
+	else{
+		std::vector<vec3> & left = this->leftB[depth];
+		std::vector<vec3> & right = this->rightB[depth];
+		left.resize( this->amountB );
+		right.resize( this->amountB );
+		this->evaluator.subdivide( 0.5, b, this->amountB, &left[0], &right[0] );
+		double middle = (b0+b1)/2;
+		this->intersectPieces( a, a0, a1, &left[0], b0, middle, depth+1 );
+		this->intersectPieces( a, a0, a1, &right[0], middle, b1, depth+1 );
+	}
+}
+
+// Gauss-Newton on |A(tA) - B(tB)|^2, the parameters stay in [0,1]
+void curveIntersector::refine( const curveView & a, const curveView & b, double & tA, double & tB ) {
+	curveView derivativeA( this->hodographA.data(), this->hodographA.size() );
+	curveView derivativeB( this->hodographB.data(), this->hodographB.size() );
+	for( int step = 0; step < newtonSteps; step++ ){
+		vec3 difference = this->evaluator.evaluate( tA, a ) - this->evaluator.evaluate( tB, b );
+		vec3 da = this->evaluator.evaluate( tA, derivativeA );
+		vec3 db = this->evaluator.evaluate( tB, derivativeB );
+		// normal equations of the 3x2 jacobian [da, -db]
+		double a11 = da.produitScalaire( da ), a12 = -da.produitScalaire( db ), a22 = db.produitScalaire( db );
+		double g1 = da.produitScalaire( difference ), g2 = -db.produitScalaire( difference );
+		double determinant = a11*a22 - a12*a12;
+		if( fabs( determinant ) <= DBL_EPSILON*( a11*a22 ) || determinant == 0 ){
+			return;		// tangent curves, the seed of the chords is kept
+		}
+		double stepA = -( a22*g1 - a12*g2 )/determinant;
+		double stepB = -( a11*g2 - a12*g1 )/determinant;
+		tA = clampParameter( tA + stepA );
+		tB = clampParameter( tB + stepB );
+		if( fabs( stepA ) < 1e-15 && fabs( stepB ) < 1e-15 ){
+			return;
+		}
+	}
+}
+
+void curveIntersector::intersect( int curveA, const curveView & a, int curveB, const curveView & b, std::vector<curveIntersection> & result ) {
+	this->candidates.clear();
+	this->amountA = a.size();
+	this->amountB = b.size();
+	this->intersectPieces( a.data(), 0, 1, b.data(), 0, 1, 0 );
+	if( this->candidates.empty() ){
+		return;
+	}
+
+	hodographOf( a, this->hodographA );
+	hodographOf( b, this->hodographB );
+	int firstNew = result.size();
+	for( int i = 0; i < this->candidates.size(); i++ ){
+		double tA = this->candidates[i].first, tB = this->candidates[i].second;
+		this->refine( a, b, tA, tB );
+		vec3 pointA = this->evaluator.evaluate( tA, a ), pointB = this->evaluator.evaluate( tB, b );
+		if( ( pointA - pointB ).norme() > this->tolerance ){
+			continue;
+		}
+		// the pieces around one intersection converge to the same parameters
+		bool isKnown = false;
+		for( int j = firstNew; j < result.size() && !isKnown; j++ ){
+			isKnown = fabs( result[j].tA - tA ) < mergeDistance && fabs( result[j].tB - tB ) < mergeDistance;
+		}
+		if( !isKnown ){
+			curveIntersection found = { curveA, tA, curveB, tB, ( pointA + pointB )*0.5 };
+			result.push_back( found );
+		}
+	}
+}
+
+// parameter at an end of the curve
+static bool isEnd( double t ){
+	return t < curveIntersector::mergeDistance || t > 1 - curveIntersector::mergeDistance;
+}
+
+void intersectAll( tessellationPool & pool, splineStore & curves, curveBVH & index, std::vector<curveIntersection> & result,
+                   double tolerance, bool ignoreJoints ){
+	std::vector< std::pair<int,int> > pairs;
+	index.overlappingPairs( pairs );
+
+	// each chunk of pairs has its own intersector and its own list
+	int chunk = 64;
+	std::vector< std::vector<curveIntersection> > found( pairs.size()/chunk + 1 );
+	pool.parallelFor( pairs.size(), chunk, [&]( int begin, int end ){
+		curveIntersector intersector( tolerance );
+		std::vector<curveIntersection> & out = found[begin/chunk];
+		for( int i = begin; i < end; i++ ){
+			int a = pairs[i].first, b = pairs[i].second;
+			intersector.intersect( a, curves[a], b, curves[b], out );
+		}
+	} );
+
+	result.clear();
+	for( int c = 0; c < found.size(); c++ ){
+		for( int i = 0; i < found[c].size(); i++ ){
+			if( !ignoreJoints || !isEnd( found[c][i].tA ) || !isEnd( found[c][i].tB ) ){
+				result.push_back( found[c][i] );
+			}
+		}
+	}
+	std::sort( result.begin(), result.end(), []( const curveIntersection & x, const curveIntersection & y ){
+		return x.curveA != y.curveA ? x.curveA < y.curveA : ( x.curveB != y.curveB ? x.curveB < y.curveB : x.tA < y.tA );
+	} );
+}
@@ -0,0 +1,62 @@
+#include <vector>
+#include "vec3.h"
+#include "casteljau.h"
+#include "curveView.h"
+#include "splineStore.h"
+#include "curveBVH.h"
+#include "parallelTessellation.h"
+
+#pragma once
+
+// Point shared by curveA at tA and curveB at tB
+struct curveIntersection
+{
+	int curveA;
+	double tA;
+	int curveB;
+	double tB;
+	vec3 point;
+};
+
+/**
+ *	Intersections of two Bezier curves by recursive subdivision.
+ * The pieces whose boxes overlap are split at 0.5 (the larger one first) until both are flat within the
+ * tolerance; the closest points of their chords then seed a Gauss-Newton refinement of (tA, tB) on the
+ * curves themselves. Intersections closer than mergeDistance in both parameters are reported once.
+ * The splitting reuses buffers per depth: one curveIntersector per thread.
+ *
+ */
+class curveIntersector
+{
+private:
+	double tolerance;
+	int maxDepth;
+	std::vector< std::vector<vec3> > leftA, rightA, leftB, rightB;	// halves of each depth
+	std::vector<vec3> hodographA, hodographB;
+	casteljauEvaluator evaluator;
+
+	void intersectPieces( const vec3 * a, double a0, double a1, const vec3 * b, double b0, double b1, int depth );
+	void refine( const curveView & a, const curveView & b, double & tA, double & tB );
+
+	// candidates of the current pair of curves
+	std::vector< std::pair<double,double> > candidates;
+	int amountA, amountB;
+
+public:
+	static double mergeDistance;
+	static int newtonSteps;
+
+	curveIntersector( double tolerance = 1e-7, int maxDepth = 40 );
+
+	void setTolerance( double tolerance );
+	double getTolerance() const;
+
+	// intersections of the curves a and b (numbered curveA and curveB in the result), appended to result
+	void intersect( int curveA, const curveView & a, int curveB, const curveView & b, std::vector<curveIntersection> & result );
+};
+
+// every intersection between distinct curves of the store, sorted by curveA, curveB then tA.
+// The pairs come from the boxes of the index (built on the same store), the pairs are intersected in parallel.
+// ignoreJoints skips the end points shared by two curves (the joints of a chain built with adjustContinuity)
+void intersectAll( tessellationPool & pool, splineStore & curves, curveBVH & index, std::vector<curveIntersection> & result,
+                   double tolerance = 1e-7, bool ignoreJoints = true );
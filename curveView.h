@@ -0,0 +1,30 @@
+#include <deque>
+#include "vec3.h"
+
+#pragma once
+
+// Non-owning view of the control points of one curve (a pointer and an amount), passed by value to the evaluators.
+// It stays valid as long as the array it points to is not reallocated (see splineStore)
+template<typename T>
+class curveViewT
+{
+private:
+	vector3<T> * points = NULL;
+	int amount = 0;
+
+public:
+	curveViewT() {}
+	curveViewT( vector3<T> * points, int amount ) : points( points ), amount( amount ) {}
+
+	int size() const { return this->amount; }
+	vector3<T> * data() const { return this->points; }
+	vector3<T> & operator[]( int i ) const { return this->points[i]; }
+	vector3<T> * begin() const { return this->points; }
+	vector3<T> * end() const { return this->points + this->amount; }
+
+	// copy for the code working on deques
+	std::deque< vector3<T> > toDeque() const { return std::deque< vector3<T> >( this->begin(), this->end() ); }
+};
+
+typedef curveViewT<double> curveView;
+typedef curveViewT<float> curveViewF;
@@ -0,0 +1,56 @@
+#include "curves.h"
+#include "bernsteinBasis.h"
+#include "math.h"
+#include "utils.h"
+#include "profiler.h"
+#include "highDegree.h"
+
+static_assert( factorials.values[5] == 120, "factorial table built at compile time" );
+
+// obtains the factorial in the table
+double getFactorial( int n ){
+    if( n >= maxFactorial ){
+        return tgamma( n+1.0 );     // beyond the table (infinite from 171)
+    }
+    return factorials.values[n];
+}
+
+// obtains the bernsteinB
+double getBernsteinB( int n, int i, double t ){
+    if( n >= maxFactorial ){
+        return bernsteinWeight( n, i, t );     // the factorials would overflow and the powers underflow
+    }
+    return (getFactorial( n )/(getFactorial( i )*getFactorial( n-i )))*pow(t,i) * pow(1-t,n-i);
+}
+
+// calculate the Bezier curve based on Bernstein algorithm. amountSamples defines the amount of samples in the curve
+std::deque<vec3> bernstein( std::deque<vec3> controlPoints, int amountSamples ){
+    PROFILE_SCOPE( timerBernstein );
+    PROFILE_COUNT( counterSamples, amountSamples+2 );
+    PROFILE_COUNT( counterAllocations, 1 );
+    // the weights only depend on the degree and the samples, they are shared between curves and frames
+    std::shared_ptr<const bernsteinBasis> basis = bernsteinBasisCache::shared().get( controlPoints.size()-1, amountSamples );
+    return basis->evaluate( controlPoints );
+}
+
+std::deque<vec3f> bernstein( std::deque<vec3f> controlPoints, int amountSamples ){
+    PROFILE_SCOPE( timerBernstein );
+    PROFILE_COUNT( counterSamples, amountSamples+2 );
+    PROFILE_COUNT( counterAllocations, 1 );
+    std::shared_ptr<const bernsteinBasis> basis = bernsteinBasisCache::shared().get( controlPoints.size()-1, amountSamples );
+    std::vector<vec3f> samples( basis->getAmountRows() );
+    basis->evaluate( controlPoints, &samples[0] );
+    return std::deque<vec3f>( samples.begin(), samples.end() );
+}
+
+// Set the position of the point 1 to the point 2
+void adjustContinuity( vec3 * controlPoint1, vec3 * controlPoint2 ){
+    *controlPoint2 = *controlPoint1;
+}
+
+// Set the inverse of the position of the point 1 to the point 2 (relative to the center)
+void adjustContinuityTangent( vec3 * centerPoint, vec3 * controlPoint1, vec3 * controlPoint2 ){
+    vec3 distance = *controlPoint1 - *centerPoint;
+
+    *controlPoint2 = *centerPoint - distance;
+}
@@ -0,0 +1,93 @@
+#include <deque>
+#include "vec3.h"
+#include "casteljau.h"
+#include "profiler.h"
+
+#pragma once
+
+// Curve kernels shared by the GLUT programs and the benchmark (no OpenGL dependency).
+// The point evaluators are templated on the precision of vector3 (vec3 or vec3f)
+
+// factorials 0 .. maxFactorial-1, computed at compile time (read-only, safe from any thread)
+const int maxFactorial = 100;
+struct factorialTable
+{
+	double values[maxFactorial];
+
+	constexpr factorialTable() : values() {
+		values[0] = 1;
+		for( int n = 1; n < maxFactorial; n++ ){
+			values[n] = values[n-1]*n;
+		}
+	}
+};
+constexpr factorialTable factorials;
+
+// calculate the position on the curve between P1 and P2 (and the tangent on these points) related to the factor u [0,1]
+template<typename T>
+vector3<T> hermite( typename vector3<T>::scalar u, const vector3<T> & p1, const vector3<T> & p2, const vector3<T> & v1, const vector3<T> & v2 ){
+    T u2 = u*u;
+    T u3 = u2*u;
+    // Factor that represents the importance of each point and tangent to the result
+    T importP1 = 2*u3 -3*u2 +1;
+    T importP2 = -2*u3 +3*u2;
+    T importV1 = u3 -2*u2 + u;
+    T importV2 = u3 -u2;
+
+    // position = iP1*P1 +  iP2*P2 +  iV1*V1 +  iV2*V2
+    return p1*importP1 + p2*importP2 + v1*importV1 + v2*importV2;
+}
+// calculate the curve between P1 and P2 (and the tangent on these points). amountSamples defines the amount of samples in the curve
+template<typename T>
+std::deque< vector3<T> > hermite( const vector3<T> & p1, const vector3<T> & p2, const vector3<T> & v1, const vector3<T> & v2, int amountSamples ){
+    PROFILE_SCOPE( timerHermite );
+    int amount = amountSamples+2;   // at least 2 samples will be created
+    PROFILE_COUNT( counterSamples, amount );
+    PROFILE_COUNT( counterAllocations, 1 );
+    std::deque< vector3<T> > result;
+    for( int i=0; i<amount; i++ ){
+        result.push_back( hermite<T>( i/((T)amount-1), p1, p2, v1, v2 ) );
+    }
+    return result;
+}
+
+// obtains the factorial in the table (tgamma from maxFactorial on)
+double getFactorial( int n );
+// obtains the bernsteinB (computed in log space from the degree maxFactorial on, see highDegree.h)
+double getBernsteinB( int n, int i, double t );
+
+// calculate the position on the Bezier curve (Bernstein) related to the factor u [0,1]. The weights are computed in double
+template<typename T>
+vector3<T> bernstein( typename vector3<T>::scalar u, const std::deque< vector3<T> > & controlPoints ){
+    // initializing the result with the first point
+    int degree = controlPoints.size()-1;
+    vector3<T> result = controlPoints[0] * (T)getBernsteinB( degree, 0, u );
+    for( int i = 1; i<controlPoints.size(); i++ ){
+        result += controlPoints[i] * (T)getBernsteinB( degree, i, u );
+    }
+    return result;
+}
+// calculate the Bezier curve based on Bernstein algorithm (weights from bernsteinBasisCache). amountSamples defines the amount of samples in the curve
+std::deque<vec3> bernstein( std::deque<vec3> controlPoints, int amountSamples );
+// same with float control points and samples (the weights are applied in double)
+std::deque<vec3f> bernstein( std::deque<vec3f> controlPoints, int amountSamples );
+
+// calculate the Bezier curve based on Casteljau algorithm (see casteljauEvaluator). amountSamples defines the amount of samples in the curve
+template<typename T>
+std::deque< vector3<T> > casteljau( const std::deque< vector3<T> > & controlPoints, int amountSamples ){
+    PROFILE_SCOPE( timerCasteljau );
+    int amount = amountSamples+2;   // at least 2 samples will be created
+    PROFILE_COUNT( counterSamples, amount );
+    PROFILE_COUNT( counterAllocations, 1 );
+    casteljauEvaluatorT<T> evaluator( controlPoints.size()-1 );
+    std::deque< vector3<T> > result;
+    for( int i=0; i<amount; i++ ){
+        result.push_back( evaluator.evaluate( i/((T)amount-1), controlPoints ) );
+    }
+    return result;
+}
+
+// Set the position of the point 1 to the point 2
+void adjustContinuity( vec3 * controlPoint1, vec3 * controlPoint2 );
+// Set the inverse of the position of the point 1 to the point 2 (relative to the center)
+void adjustContinuityTangent( vec3 * centerPoint, vec3 * controlPoint1, vec3 * controlPoint2 );
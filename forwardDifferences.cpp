@@ -0,0 +1,113 @@
+#include "forwardDifferences.h"
+#include <vector>
+#include <float.h>
+#include "math.h"
+
+forwardDifferences::forwardDifferences() {
+	for( int j = 0; j < 4; j++ ){
+		for( int c = 0; c < 3; c++ ){
+			this->coefficients[j][c] = 0;
+		}
+	}
+}
+
+void forwardDifferences::setHermite( vec3 p1, vec3 p2, vec3 v1, vec3 v2 ) {
+	double p1c[3] = { p1.getX(), p1.getY(), p1.getZ() };
+	double p2c[3] = { p2.getX(), p2.getY(), p2.getZ() };
+	double v1c[3] = { v1.getX(), v1.getY(), v1.getZ() };
+	double v2c[3] = { v2.getX(), v2.getY(), v2.getZ() };
+	for( int c = 0; c < 3; c++ ){
+		this->coefficients[0][c] = 2*p1c[c] - 2*p2c[c] + v1c[c] + v2c[c];
+		this->coefficients[1][c] = -3*p1c[c] + 3*p2c[c] - 2*v1c[c] - v2c[c];
+		this->coefficients[2][c] = v1c[c];
+		this->coefficients[3][c] = p1c[c];
+	}
+}
+
+void forwardDifferences::setBezier( vec3 p0, vec3 p1, vec3 p2, vec3 p3 ) {
+	double p0c[3] = { p0.getX(), p0.getY(), p0.getZ() };
+	double p1c[3] = { p1.getX(), p1.getY(), p1.getZ() };
+	double p2c[3] = { p2.getX(), p2.getY(), p2.getZ() };
+	double p3c[3] = { p3.getX(), p3.getY(), p3.getZ() };
+	for( int c = 0; c < 3; c++ ){
+		this->coefficients[0][c] = -p0c[c] + 3*p1c[c] - 3*p2c[c] + p3c[c];
+		this->coefficients[1][c] = 3*p0c[c] - 6*p1c[c] + 3*p2c[c];
+		this->coefficients[2][c] = -3*p0c[c] + 3*p1c[c];
+		this->coefficients[3][c] = p0c[c];
+	}
+}
+
+vec3 forwardDifferences::evaluate( double u ) const {
+	double p[3];
+	for( int c = 0; c < 3; c++ ){
+		p[c] = ((this->coefficients[0][c]*u + this->coefficients[1][c])*u + this->coefficients[2][c])*u + this->coefficients[3][c];
+	}
+	return vec3( p[0], p[1], p[2] );
+}
+
+// exact point and differences at u for the step h
+void forwardDifferences::seed( double u, double h, double * point, double * d1, double * d2, double * d3 ) const {
+	for( int c = 0; c < 3; c++ ){
+		double a = this->coefficients[0][c];
+		double b = this->coefficients[1][c];
+		double cc = this->coefficients[2][c];
+		double d = this->coefficients[3][c];
+		point[c] = ((a*u + b)*u + cc)*u + d;
+		d1[c] = a*h*(3*u*u + 3*u*h + h*h) + b*h*(2*u + h) + cc*h;
+		d2[c] = 6*a*h*h*(u + h) + 2*b*h*h;
+		d3[c] = 6*a*h*h*h;
+	}
+}
+
+void forwardDifferences::tessellate( int amountSamples, vec3 * result, int reseedInterval ) const {
+	int amount = amountSamples+2;   // at least 2 samples will be created
+	double h = 1/((double)amount-1);
+	double p[3], d1[3], d2[3], d3[3];
+
+	this->seed( 0, h, p, d1, d2, d3 );
+	for( int i = 0; i < amount; i++ ){
+		if( reseedInterval > 0 && i > 0 && i % reseedInterval == 0 ){
+			this->seed( i*h, h, p, d1, d2, d3 );
+		}
+		result[i].set( p[0], p[1], p[2] );
+		for( int c = 0; c < 3; c++ ){
+			p[c] += d1[c];
+			d1[c] += d2[c];
+			d2[c] += d3[c];
+		}
+	}
+}
+
+std::deque<vec3> forwardDifferences::tessellate( int amountSamples, int reseedInterval ) const {
+	std::vector<vec3> samples( amountSamples+2 );
+	this->tessellate( amountSamples, &samples[0], reseedInterval );
+	return std::deque<vec3>( samples.begin(), samples.end() );
+}
+
+double forwardDifferences::errorBound( int amountSamples, int reseedInterval ) const {
+	int steps = amountSamples+1;
+	if( reseedInterval > 0 && reseedInterval < steps ){
+		steps = reseedInterval;
+	}
+	double sum = 0;
+	for( int c = 0; c < 3; c++ ){
+		double s = 0;
+		for( int j = 0; j < 4; j++ ){
+			s += fabs( this->coefficients[j][c] );
+		}
+		sum = s > sum ? s : sum;
+	}
+	return DBL_EPSILON * sum * (5*steps + 8);
+}
+
+std::deque<vec3> hermiteForward( vec3 p1, vec3 p2, vec3 v1, vec3 v2, int amountSamples, int reseedInterval ){
+	forwardDifferences segment;
+	segment.setHermite( p1, p2, v1, v2 );
+	return segment.tessellate( amountSamples, reseedInterval );
+}
+
+std::deque<vec3> bezierForward( std::deque<vec3> & controlPoints, int amountSamples, int reseedInterval ){
+	forwardDifferences segment;
+	segment.setBezier( controlPoints[0], controlPoints[1], controlPoints[2], controlPoints[3] );
+	return segment.tessellate( amountSamples, reseedInterval );
+}
@@ -0,0 +1,45 @@
+#include <deque>
+#include "vec3.h"
+
+#pragma once
+
+/**
+ *	Forward differencing tessellator for one cubic segment (Hermite or Bezier).
+ * The segment is converted once to the power basis p(u) = a*u^3 + b*u^2 + c*u + d,
+ * then every uniform sample costs three vector additions:
+ *   p += D1; D1 += D2; D2 += D3
+ *
+ * Error bound (per coordinate, against the direct evaluation of the polynomial):
+ *   |error| <= eps * (|a|+|b|+|c|+|d|) * (5*k + 8)
+ * where eps is the double epsilon and k the amount of steps since the last exact seed.
+ * Reseeding every r samples restarts the differences from exact values, so k <= r.
+ *
+ */
+class forwardDifferences
+{
+private:
+	double coefficients[4][3];	// a, b, c, d for each coordinate
+
+	void seed( double u, double h, double * point, double * d1, double * d2, double * d3 ) const;
+
+public:
+	forwardDifferences();
+
+	void setHermite( vec3 p1, vec3 p2, vec3 v1, vec3 v2 );
+	void setBezier( vec3 p0, vec3 p1, vec3 p2, vec3 p3 );
+
+	// exact position on the segment (Horner)
+	vec3 evaluate( double u ) const;
+
+	// amountSamples+2 uniform samples in [0,1], as hermite()/bernstein(). reseedInterval 0 never reseeds
+	void tessellate( int amountSamples, vec3 * result, int reseedInterval = 0 ) const;
+	std::deque<vec3> tessellate( int amountSamples, int reseedInterval = 0 ) const;
+
+	// documented bound of the difference between tessellate() and evaluate()
+	double errorBound( int amountSamples, int reseedInterval = 0 ) const;
+};
+
+// calculate the Hermite curve between P1 and P2 with forward differences (same samples as hermite())
+std::deque<vec3> hermiteForward( vec3 p1, vec3 p2, vec3 v1, vec3 v2, int amountSamples, int reseedInterval = 0 );
+// calculate the cubic Bezier curve with forward differences (same samples as bernstein())
+std::deque<vec3> bezierForward( std::deque<vec3> & controlPoints, int amountSamples, int reseedInterval = 0 );
@@ -0,0 +1,132 @@
+#include "hermiteSpline.h"
+#include "math.h"
+
+void hermiteSpline::setKey( const splineKey & key ) {
+	this->key = key;
+}
+const splineKey & hermiteSpline::getKey() const {
+	return this->key;
+}
+
+// tangents of the points first .. last
+void hermiteSpline::tangents( int first, int last, const splineKey * keys ) {
+	int n = this->points.size();
+	const curveView & p = this->points;
+	for( int i = first; i <= last; i++ ){
+		if( n < 2 ){
+			this->outgoing[i] = this->incoming[i] = vec3();
+			continue;
+		}
+		// neighbours, reflected at the ends of an open spline
+		vec3 previous, next;
+		if( this->closed ){
+			previous = p[( i+n-1 ) % n];
+			next = p[( i+1 ) % n];
+		}else{
+			previous = i > 0 ? p[i-1] : p[0]*2. - p[1];
+			next = i < n-1 ? p[i+1] : p[n-1]*2. - p[n-2];
+		}
+		vec3 before = p[i] - previous, after = next - p[i];
+		const splineKey & k = keys != NULL ? keys[i] : this->key;
+		double scale = ( 1-k.tension )/2;
+		this->outgoing[i] = before*( scale*( 1+k.bias )*( 1+k.continuity ) ) + after*( scale*( 1-k.bias )*( 1-k.continuity ) );
+		this->incoming[i] = before*( scale*( 1+k.bias )*( 1-k.continuity ) ) + after*( scale*( 1-k.bias )*( 1+k.continuity ) );
+	}
+}
+
+void hermiteSpline::build( const curveView & points, bool closed, const splineKey * keys ) {
+	this->points = points;
+	this->closed = closed;
+	this->outgoing.resize( points.size() );
+	this->incoming.resize( points.size() );
+	this->tangents( 0, points.size()-1, keys );
+}
+
+void hermiteSpline::build( tessellationPool & pool, const curveView & points, bool closed, const splineKey * keys ) {
+	this->points = points;
+	this->closed = closed;
+	this->outgoing.resize( points.size() );
+	this->incoming.resize( points.size() );
+	int chunk = points.size()/(8*pool.getAmountThreads()) + 1;
+	pool.parallelFor( points.size(), chunk, [&]( int begin, int end ){
+		this->tangents( begin, end-1, keys );
+	} );
+}
+
+int hermiteSpline::getAmountPoints() const {
+	return this->points.size();
+}
+
+int hermiteSpline::getAmountSegments() const {
+	int n = this->points.size();
+	return n < 2 ? 0 : ( this->closed ? n : n-1 );
+}
+
+const vec3 & hermiteSpline::getOutgoing( int point ) const {
+	return this->outgoing[point];
+}
+const vec3 & hermiteSpline::getIncoming( int point ) const {
+	return this->incoming[point];
+}
+
+// power coefficients of the segment, u^3 first: hermiteBasis * [Pi P(i+1) outgoing(i) incoming(i+1)]
+void hermiteSpline::coefficients( int segment, vec3 * result ) const {
+	int next = ( segment+1 ) % this->points.size();
+	const vec3 geometry[4] = { this->points[segment], this->points[next], this->outgoing[segment], this->incoming[next] };
+	for( int r = 0; r < 4; r++ ){
+		result[r] = geometry[0]*hermiteBasis[r][0] + geometry[1]*hermiteBasis[r][1] + geometry[2]*hermiteBasis[r][2] + geometry[3]*hermiteBasis[r][3];
+	}
+}
+
+vec3 hermiteSpline::evaluate( double t ) const {
+	int segments = this->getAmountSegments();
+	if( segments == 0 ){
+		return this->points.size() > 0 ? this->points[0] : vec3();
+	}
+	t = t < 0 ? 0 : ( t > segments ? segments : t );
+	int segment = (int)floor( t );
+	segment = segment >= segments ? segments-1 : segment;
+	double u = t - segment;
+	vec3 c[4];
+	this->coefficients( segment, c );
+	return ( ( c[0]*u + c[1] )*u + c[2] )*u + c[3];
+}
+
+long long hermiteSpline::getAmountSamples( int samplesPerSegment ) const {
+	int segments = this->getAmountSegments();
+	return segments == 0 ? ( this->points.size() > 0 ? 1 : 0 ) : (long long)segments*samplesPerSegment + 1;
+}
+
+void hermiteSpline::sample( tessellationPool & pool, int samplesPerSegment, vec3 * result ) const {
+	int segments = this->getAmountSegments();
+	if( segments == 0 ){
+		if( this->points.size() > 0 ){
+			result[0] = this->points[0];
+		}
+		return;
+	}
+	std::vector<double> parameters( samplesPerSegment );
+	for( int s = 0; s < samplesPerSegment; s++ ){
+		parameters[s] = s/(double)samplesPerSegment;
+	}
+	int chunk = segments/(8*pool.getAmountThreads()) + 1;
+	pool.parallelFor( segments, chunk, [&]( int begin, int end ){
+		vec3 c[4];
+		for( int i = begin; i < end; i++ ){
+			this->coefficients( i, c );
+			vec3 * out = result + (long long)i*samplesPerSegment;
+			for( int s = 0; s < samplesPerSegment; s++ ){
+				double u = parameters[s];
+				out[s] = ( ( c[0]*u + c[1] )*u + c[2] )*u + c[3];
+			}
+		}
+	} );
+	result[(long long)segments*samplesPerSegment] = this->points[segments % this->points.size()];
+}
+
+void hermiteSpline::sample( tessellationPool & pool, int samplesPerSegment, std::vector<vec3> & result ) const {
+	result.resize( this->getAmountSamples( samplesPerSegment ) );
+	if( !result.empty() ){
+		this->sample( pool, samplesPerSegment, &result[0] );
+	}
+}
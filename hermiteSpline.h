@@ -0,0 +1,73 @@
+#include <vector>
+#include "vec3.h"
+#include "curveView.h"
+#include "parallelTessellation.h"
+
+#pragma once
+
+// Kochanek-Bartels parameters of one point: all 0 for Catmull-Rom, only the tension for a cardinal spline
+struct splineKey
+{
+	double tension = 0;	// 1 flattens the tangent, -1 doubles it
+	double continuity = 0;	// non 0 gives different incoming and outgoing tangents (corners)
+	double bias = 0;	// -1 follows the next point, 1 the previous one
+};
+
+// Hermite basis in matrix form: p(u) = [u^3 u^2 u 1] * hermiteBasis * [P0 P1 T0 T1], same polynomials as hermite()
+constexpr double hermiteBasis[4][4] = {
+	{  2, -2,  1,  1 },
+	{ -3,  3, -2, -1 },
+	{  0,  0,  1,  0 },
+	{  1,  0,  0,  0 }
+};
+
+/**
+ *	Kochanek-Bartels (Catmull-Rom, cardinal) spline through a sequence of points, for camera and motion paths.
+ * Segment i is the Hermite curve from point i to point i+1 (uniform parameters), with the tangents computed for
+ * every point at once by build(): the outgoing tangent starts segment i, the incoming one ends segment i-1.
+ * Open splines extend the sequence by reflection (P(-1) = 2 P0 - P1), closed ones wrap around.
+ * The sampler multiplies the basis matrix once per segment to get the power coefficients, then evaluates each
+ * sample with Horner (3 multiply-adds per coordinate) on the tessellation pool.
+ * The points are not copied (a curveView into a splineStore or a mapped curve file): they must outlive the spline
+ * and build() is called again after they change.
+ *
+ */
+class hermiteSpline
+{
+private:
+	curveView points;
+	bool closed = false;
+	splineKey key;
+	std::vector<vec3> outgoing, incoming;
+
+	void tangents( int first, int last, const splineKey * keys );
+	void coefficients( int segment, vec3 * result ) const;
+
+public:
+	hermiteSpline() {}
+	hermiteSpline( const splineKey & key ) : key( key ) {}
+
+	// parameters of every point when build() receives no keys
+	void setKey( const splineKey & key );
+	const splineKey & getKey() const;
+
+	// tangents of every point, keys (when not NULL) holds the parameters of each point
+	void build( const curveView & points, bool closed = false, const splineKey * keys = NULL );
+	// same, the tangents are computed in parallel
+	void build( tessellationPool & pool, const curveView & points, bool closed = false, const splineKey * keys = NULL );
+
+	int getAmountPoints() const;
+	// amount-1 for an open spline, amount for a closed one
+	int getAmountSegments() const;
+	const vec3 & getOutgoing( int point ) const;
+	const vec3 & getIncoming( int point ) const;
+
+	// position at t in [0, getAmountSegments()]: segment floor(t) at u = t - floor(t)
+	vec3 evaluate( double t ) const;
+
+	// samplesPerSegment samples of each segment (u = s/samplesPerSegment) then the end of the last one:
+	// segments*samplesPerSegment + 1 points, sample k*samplesPerSegment is exactly point k
+	long long getAmountSamples( int samplesPerSegment ) const;
+	void sample( tessellationPool & pool, int samplesPerSegment, vec3 * result ) const;
+	void sample( tessellationPool & pool, int samplesPerSegment, std::vector<vec3> & result ) const;
+};
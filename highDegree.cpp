@@ -0,0 +1,188 @@
+#include "highDegree.h"
+#include "math.h"
+
+void bernsteinRow( int degree, double t, double * weights ){
+	int n = degree;
+	for( int i = 0; i <= n; i++ ){
+		weights[i] = 0;
+	}
+	if( t <= 0 || n == 0 ){
+		weights[0] = 1;
+		return;
+	}
+	if( t >= 1 ){
+		weights[n] = 1;
+		return;
+	}
+	int m = (int)( (n+1)*t );
+	m = m > n ? n : m;
+	double ratio = t/(1-t);
+	weights[m] = 1;
+	for( int i = m; i < n; i++ ){
+		weights[i+1] = weights[i] * ( (n-i)/(double)(i+1) ) * ratio;
+	}
+	for( int i = m; i > 0; i-- ){
+		weights[i-1] = weights[i] * ( i/(double)(n-i+1) ) / ratio;
+	}
+	double sum = 0;
+	for( int i = 0; i <= n; i++ ){
+		sum += weights[i];
+	}
+	for( int i = 0; i <= n; i++ ){
+		weights[i] /= sum;
+	}
+}
+
+double bernsteinWeight( int degree, int i, double t ){
+	if( t <= 0 ){
+		return i == 0 ? 1 : 0;
+	}
+	if( t >= 1 ){
+		return i == degree ? 1 : 0;
+	}
+	double logBinomial = lgamma( degree+1.0 ) - lgamma( i+1.0 ) - lgamma( degree-i+1.0 );
+	return exp( logBinomial + i*log( t ) + (degree-i)*log1p( -t ) );
+}
+
+template<typename Points>
+vec3 highDegreeEvaluator::evaluatePoints( double u, const Points & controlPoints ) {
+	int n = controlPoints.size()-1;
+	this->weights.resize( n+1 );
+	bernsteinRow( n, u, &this->weights[0] );
+	double x = 0, y = 0, z = 0;
+	for( int i = 0; i <= n; i++ ){
+		double w = this->weights[i];
+		x += controlPoints[i].getX()*w;
+		y += controlPoints[i].getY()*w;
+		z += controlPoints[i].getZ()*w;
+	}
+	return vec3( x, y, z );
+}
+
+vec3 highDegreeEvaluator::evaluate( double u, const std::deque<vec3> & controlPoints ) {
+	return this->evaluatePoints( u, controlPoints );
+}
+
+vec3 highDegreeEvaluator::evaluate( double u, const curveView & controlPoints ) {
+	return this->evaluatePoints( u, controlPoints );
+}
+
+void highDegreeEvaluator::tessellate( const curveView & controlPoints, int amountSamples, vec3 * result ) {
+	int amount = amountSamples+2;   // at least 2 samples will be created
+	for( int s = 0; s < amount; s++ ){
+		result[s] = this->evaluatePoints( s/((double)amount-1), controlPoints );
+	}
+}
+
+void elevateDegree( const vec3 * controlPoints, int amount, vec3 * result ){
+	int n = amount-1;
+	result[0] = controlPoints[0];
+	for( int i = 1; i <= n; i++ ){
+		double a = i/(double)(n+1);
+		result[i] = controlPoints[i-1]*a + controlPoints[i]*(1-a);
+	}
+	result[n+1] = controlPoints[n];
+}
+
+// inverse of elevateDegree: Pi = i/n Q(i-1) + (1-i/n) Qi solved for Q from both ends
+static void reduceOnce( const vec3 * controlPoints, int amount, vec3 * result ){
+	int n = amount-1;
+	int half = n/2;
+	for( int i = 0; i < half; i++ ){
+		result[i] = i == 0 ? controlPoints[0] : ( controlPoints[i]*(double)n - result[i-1]*(double)i ) / (double)(n-i);
+	}
+	for( int i = n; i > half; i-- ){
+		result[i-1] = i == n ? controlPoints[n] : ( controlPoints[i]*(double)n - result[i]*(double)(n-i) ) / (double)i;
+	}
+}
+
+// largest distance between the control points
+static double controlPointsDistance( const vec3 * a, const vec3 * b, int amount ){
+	double distance = 0;
+	for( int i = 0; i < amount; i++ ){
+		distance = fmax( distance, ( a[i] - b[i] ).norme() );
+	}
+	return distance;
+}
+
+double reduceDegree( const vec3 * controlPoints, int amount, vec3 * result ){
+	reduceOnce( controlPoints, amount, result );
+	std::vector<vec3> elevated( amount );
+	elevateDegree( result, amount-1, &elevated[0] );
+	return controlPointsDistance( controlPoints, &elevated[0], amount );
+}
+
+degreeReducer::degreeReducer( int degree, double tolerance, int maxDepth ) {
+	this->setDegree( degree );
+	this->tolerance = tolerance;
+	this->maxDepth = maxDepth;
+	this->left.resize( maxDepth );
+	this->right.resize( maxDepth );
+}
+
+void degreeReducer::setDegree( int degree ) {
+	this->degree = degree < 1 ? 1 : degree;
+}
+int degreeReducer::getDegree() const {
+	return this->degree;
+}
+void degreeReducer::setTolerance( double tolerance ) {
+	this->tolerance = tolerance;
+}
+double degreeReducer::getTolerance() const {
+	return this->tolerance;
+}
+
+// reduces the piece down to the degree (in reduced) and returns the bound of the distance to the piece
+double degreeReducer::reduce( const vec3 * controlPoints, int amount ) {
+	int target = this->degree+1;
+	this->reduced.assign( controlPoints, controlPoints+amount );
+	this->scratch.resize( amount );
+	for( int n = amount; n > target; n-- ){
+		reduceOnce( &this->reduced[0], n, &this->scratch[0] );
+		this->reduced.swap( this->scratch );
+	}
+	this->reduced.resize( target );
+
+	// back to the degree of the piece, the difference of the two curves is bounded by its control points
+	this->elevated.assign( this->reduced.begin(), this->reduced.end() );
+	this->scratch.resize( amount );
+	for( int n = target; n < amount; n++ ){
+		this->elevated.resize( amount );
+		elevateDegree( &this->elevated[0], n, &this->scratch[0] );
+		this->elevated.swap( this->scratch );
+	}
+	return controlPointsDistance( controlPoints, &this->elevated[0], amount );
+}
+
+// the piece [u0,u1] of the curve
+void degreeReducer::convert( const vec3 * controlPoints, int amount, double u0, double u1, int depth, splineStore & result, std::vector<double> * parameters ) {
+	if( amount <= this->degree+1 ){
+		if( parameters != NULL ){
+			parameters->push_back( u0 );
+		}
+		result.addCurve( controlPoints, amount );
+		return;
+	}
+	if( this->reduce( controlPoints, amount ) <= this->tolerance || depth >= this->maxDepth ){
+		if( parameters != NULL ){
+			parameters->push_back( u0 );
+		}
+		result.addCurve( &this->reduced[0], this->reduced.size() );
+		return;
+	}
+	std::vector<vec3> & leftHalf = this->left[depth];
+	std::vector<vec3> & rightHalf = this->right[depth];
+	leftHalf.resize( amount );
+	rightHalf.resize( amount );
+	this->evaluator.subdivide( 0.5, controlPoints, amount, &leftHalf[0], &rightHalf[0] );
+	double middle = (u0+u1)/2;
+	this->convert( &leftHalf[0], amount, u0, middle, depth+1, result, parameters );
+	this->convert( &rightHalf[0], amount, middle, u1, depth+1, result, parameters );
+}
+
+int degreeReducer::convert( const curveView & controlPoints, splineStore & result, std::vector<double> * parameters ) {
+	int first = result.size();
+	this->convert( controlPoints.data(), controlPoints.size(), 0, 1, 0, result, parameters );
+	return result.size() - first;
+}
@@ -0,0 +1,77 @@
+#include <deque>
+#include <vector>
+#include "vec3.h"
+#include "curveView.h"
+#include "casteljau.h"
+#include "splineStore.h"
+
+#pragma once
+
+// Bezier curves of any degree (fitted curves of several hundred control points): no factorial table,
+// no pow, and conversions to curves of a lower degree
+
+// the degree+1 Bernstein polynomials of the degree at t, in O(degree). The row starts at the most likely
+// index floor((degree+1)*t) and moves outwards with the ratios B(i+1)/B(i) = (n-i)/(i+1) * t/(1-t), which
+// are at most 1 on both sides: the far weights underflow to 0 instead of overflowing, then the row is divided
+// by its sum (the polynomials sum to 1)
+void bernsteinRow( int degree, double t, double * weights );
+// one Bernstein polynomial B(degree,i,t) with the binomial computed in log space (any degree)
+double bernsteinWeight( int degree, int i, double t );
+
+// Evaluator of Bezier curves of any degree, O(n) per sample with bernsteinRow (one scratch row reused)
+class highDegreeEvaluator
+{
+private:
+	std::vector<double> weights;
+
+	template<typename Points>
+	vec3 evaluatePoints( double u, const Points & controlPoints );
+
+public:
+	vec3 evaluate( double u, const std::deque<vec3> & controlPoints );
+	vec3 evaluate( double u, const curveView & controlPoints );
+	// amountSamples+2 points at the same parameters as bernstein( controlPoints, amountSamples )
+	void tessellate( const curveView & controlPoints, int amountSamples, vec3 * result );
+};
+
+// same curve with one more control point: result holds amount+1 points
+void elevateDegree( const vec3 * controlPoints, int amount, vec3 * result );
+// curve of one degree less (amount-1 points) keeping both end points: the inner points are solved from the
+// elevation formulas, from the first point up to the middle and from the last point down to the middle
+// (Forrest), so that each step only damps the error of the previous one. Exact when the curve is an elevated
+// one; returns a bound of the distance between the two curves (largest distance between the control points
+// of the original and of the result elevated back)
+double reduceDegree( const vec3 * controlPoints, int amount, vec3 * result );
+
+/**
+ *	Converts a curve into consecutive pieces of at most the given degree, each within tolerance of the curve.
+ * The curve is split at 0.5 (de Casteljau) until its pieces, reduced down to the degree and elevated back,
+ * have control points within the tolerance of the piece (a bound of the distance between the two curves).
+ * The pieces share their end points: the chain is continuous.
+ *
+ */
+class degreeReducer
+{
+private:
+	int degree;
+	double tolerance;
+	int maxDepth;
+	casteljauEvaluator evaluator;
+	std::vector< std::vector<vec3> > left, right;	// halves of each depth
+	std::vector<vec3> reduced, elevated, scratch;
+
+	double reduce( const vec3 * controlPoints, int amount );
+	void convert( const vec3 * controlPoints, int amount, double u0, double u1, int depth, splineStore & result, std::vector<double> * parameters );
+
+public:
+	degreeReducer( int degree = 3, double tolerance = 1e-6, int maxDepth = 30 );
+
+	void setDegree( int degree );
+	int getDegree() const;
+	void setTolerance( double tolerance );
+	double getTolerance() const;
+
+	// appends the pieces to result and returns their amount. parameters (when not NULL) receives the parameter
+	// of the curve where each piece starts: piece k covers [parameters[k], parameters[k+1]) of the curve, 1 ends the last one
+	int convert( const curveView & controlPoints, splineStore & result, std::vector<double> * parameters = NULL );
+};
@@ -0,0 +1,1070 @@
+/**
+ *	Microbenchmark of the curve kernels (no OpenGL)
+ * Each case is repeated until it ran for at least minMillis milliseconds,
+ * then the throughput is reported in samples/sec and ns/sample.
+ *   bench [minMillis]
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <vector>
+#include "vec3.h"
+#include "utils.h"
+#include "curves.h"
+#include "casteljau.h"
+#include "forwardDifferences.h"
+#include "powerBasis.h"
+#include "curveBatch.h"
+#include "parallelTessellation.h"
+#include "adaptiveTessellation.h"
+#include "tessellationCache.h"
+#include "bernsteinBasis.h"
+#include "subdivision.h"
+#include "subdivisionSchemes.h"
+#include "bezierFixed.h"
+#include "splineStore.h"
+#include "arcLength.h"
+#include "curveBVH.h"
+#include "curveIntersection.h"
+#include "curveFile.h"
+#include "profiler.h"
+#include "highDegree.h"
+#include "splineChain.h"
+#include "hermiteSpline.h"
+
+double minMillis = 100;
+double checksum = 0;        // keeps the compiler from dropping the evaluations
+
+// control polygon of the given degree laid on a sine wave
+std::deque<vec3> benchControlPoints( int degree ){
+    std::deque<vec3> controlPoints;
+    FOR(i,degree+1){
+        controlPoints.push_back( vec3( i, sin( i*1.3 )*2, 0 ) );
+    }
+    return controlPoints;
+}
+
+// accumulate the samples of a curve into the checksum
+void consume( std::deque<vec3> vertices ){
+    FOR(i,vertices.size()){
+        checksum += vertices[i].getX() + vertices[i].getY();
+    }
+}
+
+// float copy of control points
+std::deque<vec3f> toFloat( const std::deque<vec3> & points ){
+    std::deque<vec3f> result;
+    FOR(i,points.size()){
+        result.push_back( vec3f( points[i] ) );
+    }
+    return result;
+}
+
+// largest difference of a coordinate between the reference and the values (e.g. the double and the float paths)
+template<typename Reference, typename Values>
+double maxCoordinateError( const Reference & reference, const Values & values, int amount ){
+    double maxError = 0;
+    FOR(i,amount){
+        double errors[3] = { fabs( reference[i].getX()-values[i].getX() ), fabs( reference[i].getY()-values[i].getY() ), fabs( reference[i].getZ()-values[i].getZ() ) };
+        FOR(c,3){
+            maxError = errors[c] > maxError ? errors[c] : maxError;
+        }
+    }
+    return maxError;
+}
+
+// checks that failed: the benchmark exits with 1 when there is any
+int failures = 0;
+
+// prints an error line and counts a failed check
+void fail( const char * message ){
+    printf( "ERROR %s\n", message );
+    failures++;
+}
+
+// the float paths further than this from the double path fail the benchmark. The bound is
+// relative to the size of the coordinates when they are above 1 (float keeps 24 bits of mantissa)
+const double floatTolerance = 1e-5;
+
+// largest absolute coordinate of the points
+template<typename Points>
+double maxCoordinate( const Points & points, int amount ){
+    double result = 0;
+    FOR(i,amount){
+        result = fmax( result, fmax( fabs( points[i].getX() ), fmax( fabs( points[i].getY() ), fabs( points[i].getZ() ) ) ) );
+    }
+    return result;
+}
+
+// prints the error of a float path against the double path, and an error line when it is above the tolerance
+void checkFloatError( const char * algorithm, const char * parameter, int value, double error, double scale = 1 ){
+    double bound = floatTolerance*fmax( 1, scale );
+    printf( "%-12s %-6s %6d max error %.3g (bound %.3g)\n", algorithm, parameter, value, error, bound );
+    if( !( error <= bound ) ){
+        char message[160];
+        snprintf( message, sizeof(message), "%s %s %d: float error %.3g above %.3g", algorithm, parameter, value, error, bound );
+        fail( message );
+    }
+}
+
+// run the kernel until minMillis is elapsed and print one line of the report
+template<typename Kernel>
+void measure( const char * algorithm, const char * parameter, int value, long long samplesPerRun, Kernel kernel ){
+    typedef std::chrono::steady_clock clock;
+    long long runs = 0;
+    double elapsedNs = 0;
+    clock::time_point start = clock::now();
+    while( elapsedNs < minMillis*1e6 ){
+        kernel();
+        runs++;
+        elapsedNs = std::chrono::duration<double, std::nano>( clock::now() - start ).count();
+    }
+    double samples = (double)runs*samplesPerRun;
+    printf( "%-12s %-10s %8d %12lld %14.1f %16.0f\n", algorithm, parameter, value, samplesPerRun, elapsedNs/samples, samples/(elapsedNs*1e-9) );
+}
+
+int main(int argc, char **argv)
+{
+    if( argc > 1 ){
+        minMillis = atof( argv[1] );
+    }
+
+    int degrees[] = { 2, 3, 5, 8, 12 };
+    int amountSamples[] = { 10, 100, 1000 };
+    char parameter[32];
+
+    printf( "%-12s %-10s %8s %12s %14s %16s\n", "algorithm", "parameter", "value", "samples/run", "ns/sample", "samples/sec" );
+
+    // hermite (cubic)
+    vec3 p1( -2,-2,0 ), p2( 2,-2,0 ), v1( 1,5,0 ), v2( 1,-5,0 );
+    FOR(s,3){
+        int amount = amountSamples[s];
+        measure( "hermite", "samples", amount, amount+2, [&](){ consume( hermite( p1, p2, v1, v2, amount ) ); } );
+    }
+
+    // forward differences (hermite and cubic bezier), without and with reseeding every 64 samples
+    forwardDifferences hermiteSegment, bezierSegment;
+    std::deque<vec3> cubic = benchControlPoints( 3 );
+    hermiteSegment.setHermite( p1, p2, v1, v2 );
+    bezierSegment.setBezier( cubic[0], cubic[1], cubic[2], cubic[3] );
+    FOR(s,3){
+        int amount = amountSamples[s];
+        std::vector<vec3> vertices( amount+2 );
+        measure( "hermiteFwd", "samples", amount, amount+2, [&](){ hermiteSegment.tessellate( amount, &vertices[0] ); checksum += vertices[amount/2].getX(); } );
+        measure( "bezierFwd", "samples", amount, amount+2, [&](){ bezierSegment.tessellate( amount, &vertices[0] ); checksum += vertices[amount/2].getX(); } );
+        measure( "bezierFwd64", "samples", amount, amount+2, [&](){ bezierSegment.tessellate( amount, &vertices[0], 64 ); checksum += vertices[amount/2].getX(); } );
+    }
+    // drift of the forward differences against the direct evaluation
+    int driftSamples[] = { 1000, 100000 };
+    FOR(s,2){
+        int amount = driftSamples[s];
+        std::vector<vec3> vertices( amount+2 );
+        int reseed[] = { 0, 64 };
+        FOR(r,2){
+            bezierSegment.tessellate( amount, &vertices[0], reseed[r] );
+            double maxError = 0;
+            FOR(i,amount+2){
+                vec3 direct = bezierSegment.evaluate( i/((double)amount+1) );
+                double errors[3] = { fabs( direct.getX()-vertices[i].getX() ), fabs( direct.getY()-vertices[i].getY() ), fabs( direct.getZ()-vertices[i].getZ() ) };
+                FOR(c,3){
+                    maxError = errors[c] > maxError ? errors[c] : maxError;
+                }
+            }
+            printf( "%-12s samples %8d reseed %4d  max error %.3g  bound %.3g\n", "bezierFwd", amount, reseed[r], maxError, bezierSegment.errorBound( amount, reseed[r] ) );
+        }
+    }
+
+    // bernstein
+    FOR(d,5){
+        std::deque<vec3> controlPoints = benchControlPoints( degrees[d] );
+        FOR(s,3){
+            int amount = amountSamples[s];
+            snprintf( parameter, sizeof(parameter), "deg%d/smp", degrees[d] );
+            measure( "bernstein", parameter, amount, amount+2, [&](){ consume( bernstein( controlPoints, amount ) ); } );
+        }
+    }
+
+    // bernstein evaluated per sample with getBernsteinB (no basis cache)
+    FOR(d,5){
+        std::deque<vec3> controlPoints = benchControlPoints( degrees[d] );
+        FOR(s,3){
+            int amount = amountSamples[s]+2;
+            snprintf( parameter, sizeof(parameter), "deg%d/smp", degrees[d] );
+            measure( "bernsteinB", parameter, amountSamples[s], amount, [&](){
+                FOR(i,amount){
+                    checksum += bernstein( i/((double)amount-1), controlPoints ).getX();
+                }
+            } );
+        }
+    }
+
+    // bernstein with the degree fixed at compile time (degrees above maxFixedDegree take the generic path),
+    // per sample against bernsteinB and per curve against bernstein
+    FOR(d,5){
+        std::deque<vec3> controlPoints = benchControlPoints( degrees[d] );
+        FOR(s,3){
+            int amount = amountSamples[s]+2;
+            std::vector<vec3> vertices( amount );
+            snprintf( parameter, sizeof(parameter), "deg%d/smp", degrees[d] );
+            measure( "bernsteinDsp", parameter, amountSamples[s], amount, [&](){
+                FOR(i,amount){
+                    checksum += bernsteinDispatch( i/((double)amount-1), controlPoints ).getX();
+                }
+            } );
+            measure( "bernsteinDsB", parameter, amountSamples[s], amount, [&](){
+                bernsteinDispatch( controlPoints, amountSamples[s], &vertices[0] );
+                checksum += vertices[amount/2].getX();
+            } );
+        }
+        std::deque<vec3> reference = bernstein( controlPoints, 1000 );
+        std::vector<vec3> vertices( reference.size() );
+        bernsteinDispatch( controlPoints, 1000, &vertices[0] );
+        printf( "%-12s deg%-6d max error %.3g\n", "bernsteinDsB", degrees[d], maxCoordinateError( reference, vertices, reference.size() ) );
+    }
+
+    // casteljau
+    FOR(d,5){
+        std::deque<vec3> controlPoints = benchControlPoints( degrees[d] );
+        FOR(s,3){
+            int amount = amountSamples[s];
+            snprintf( parameter, sizeof(parameter), "deg%d/smp", degrees[d] );
+            measure( "casteljau", parameter, amount, amount+2, [&](){ consume( casteljau( controlPoints, amount ) ); } );
+        }
+    }
+
+    // casteljau batch entry point (parameters and output preallocated)
+    FOR(d,5){
+        std::deque<vec3> controlPoints = benchControlPoints( degrees[d] );
+        casteljauEvaluator evaluator( degrees[d] );
+        FOR(s,3){
+            int amount = amountSamples[s]+2;
+            std::vector<double> u( amount );
+            std::vector<vec3> vertices( amount );
+            FOR(i,amount){
+                u[i] = i/((double)amount-1);
+            }
+            snprintf( parameter, sizeof(parameter), "deg%d/smp", degrees[d] );
+            measure( "casteljauBat", parameter, amountSamples[s], amount, [&](){
+                evaluator.evaluate( &u[0], amount, controlPoints, &vertices[0] );
+                checksum += vertices[amount/2].getX();
+            } );
+        }
+    }
+
+    // float path of the batch entry point (half the bytes per vertex), and its error against the double path
+    FOR(d,5){
+        std::deque<vec3> controlPoints = benchControlPoints( degrees[d] );
+        std::deque<vec3f> controlPointsF = toFloat( controlPoints );
+        casteljauEvaluator evaluator( degrees[d] );
+        casteljauEvaluatorF evaluatorF( degrees[d] );
+        FOR(s,3){
+            int amount = amountSamples[s]+2;
+            std::vector<float> u( amount );
+            std::vector<vec3f> vertices( amount );
+            FOR(i,amount){
+                u[i] = i/((float)amount-1);
+            }
+            snprintf( parameter, sizeof(parameter), "deg%d/smp", degrees[d] );
+            measure( "casteljauF", parameter, amountSamples[s], amount, [&](){
+                evaluatorF.evaluate( &u[0], amount, controlPointsF, &vertices[0] );
+                checksum += vertices[amount/2].getX();
+            } );
+        }
+        int amount = 1002;
+        std::vector<double> u( amount );
+        std::vector<float> uF( amount );
+        std::vector<vec3> reference( amount );
+        std::vector<vec3f> vertices( amount );
+        FOR(i,amount){
+            u[i] = i/((double)amount-1);
+            uF[i] = u[i];
+        }
+        evaluator.evaluate( &u[0], amount, controlPoints, &reference[0] );
+        evaluatorF.evaluate( &uF[0], amount, controlPointsF, &vertices[0] );
+        checkFloatError( "casteljauF", "degree", degrees[d], maxCoordinateError( reference, vertices, amount ) );
+
+        // cached Bernstein weights applied to float control points
+        std::deque<vec3> referenceBernstein = bernstein( controlPoints, 1000 );
+        std::deque<vec3f> verticesBernstein = bernstein( controlPointsF, 1000 );
+        checkFloatError( "bernsteinF", "degree", degrees[d], maxCoordinateError( referenceBernstein, verticesBernstein, referenceBernstein.size() ) );
+    }
+    printf( "%-12s %d bytes per vertex, %d in double\n", "float", (int)sizeof(vec3f), (int)sizeof(vec3) );
+    {
+        vec3f p1F( p1 ), p2F( p2 ), v1F( v1 ), v2F( v2 );
+        std::deque<vec3> reference = hermite( p1, p2, v1, v2, 1000 );
+        std::deque<vec3f> vertices = hermite( p1F, p2F, v1F, v2F, 1000 );
+        checkFloatError( "hermiteF", "smp", 1000, maxCoordinateError( reference, vertices, reference.size() ) );
+    }
+
+    // power basis (horner), segments converted once; high degrees fall back to de Casteljau
+    FOR(d,5){
+        std::deque<vec3> controlPoints = benchControlPoints( degrees[d] );
+        powerBasisSegment segment( controlPoints );
+        FOR(s,3){
+            int amount = amountSamples[s];
+            std::vector<vec3> vertices( amount+2 );
+            snprintf( parameter, sizeof(parameter), segment.usesPowerBasis() ? "deg%d/smp" : "deg%d/smp*", degrees[d] );
+            measure( "horner", parameter, amount, amount+2, [&](){ segment.tessellate( amount, &vertices[0] ); checksum += vertices[amount/2].getX(); } );
+        }
+    }
+
+    // SoA batch of cubic segments, every kernel available on this CPU
+    cubicBatch batch;
+    int amountSegments = 10000;
+    batch.reserve( amountSegments );
+    FOR(i,amountSegments){
+        vec3 shift( i*0.01, i%7, 0 );
+        batch.addBezier( cubic[0].addition( shift ), cubic[1].addition( shift ), cubic[2].addition( shift ), cubic[3].addition( shift ) );
+    }
+    std::vector<double> batchX( 12*amountSegments ), batchY( 12*amountSegments ), batchZ( 12*amountSegments );
+    for( int level = SIMD_SCALAR; level <= detectSimdLevel(); level++ ){
+        batch.setLevel( (simdLevel)level );
+        measure( "cubicBatch", simdLevelName( (simdLevel)level ), amountSegments, 12LL*amountSegments, [&](){ batch.tessellate( 10, &batchX[0], &batchY[0], &batchZ[0] ); checksum += batchX[5*amountSegments]; } );
+    }
+
+    // spline chain tessellated in parallel, compared byte for byte with one thread
+    std::deque< std::deque<vec3> > chain;
+    FOR(i,amountSegments){
+        std::deque<vec3> curve;
+        FOR(j,4){
+            curve.push_back( cubic[j].addition( vec3( i*3, 0, 0 ) ) );
+        }
+        chain.push_back( curve );
+    }
+    std::vector<vec3> serialVertices, parallelVertices;
+    std::vector<int> offsets;
+    {
+        tessellationPool serial( 1 );
+        tessellateBezierChain( serial, chain, 10, true, serialVertices, offsets );
+    }
+    int amountThreads[] = { 1, 2, 4, 8 };
+    FOR(t,4){
+        tessellationPool threads( amountThreads[t] );
+        FOR(m,2){
+            bool isBernsteinChain = m == 0;
+            measure( isBernsteinChain ? "chainBern" : "chainCast", "threads", amountThreads[t], 12LL*amountSegments, [&](){
+                tessellateBezierChain( threads, chain, 10, isBernsteinChain, parallelVertices, offsets );
+                checksum += parallelVertices[7].getX();
+            } );
+        }
+        tessellateBezierChain( threads, chain, 10, true, parallelVertices, offsets );
+        if( memcmp( &serialVertices[0], &parallelVertices[0], serialVertices.size()*sizeof(vec3) ) != 0 ){
+            char message[80];
+            snprintf( message, sizeof(message), "chain with %d threads differs from the serial tessellation", amountThreads[t] );
+            fail( message );
+        }
+    }
+
+    // same chain from the flat spline store (one array of control points, curveViews into it)
+    {
+        splineStore store;
+        store.reserve( chain.size(), 4*chain.size() );
+        FOR(i,chain.size()){
+            store.addCurve( chain[i] );
+        }
+        tessellationPool serial( 1 );
+        FOR(m,2){
+            bool isBernsteinChain = m == 0;
+            measure( isBernsteinChain ? "chainBern" : "chainCast", "deques", chain.size(), 12LL*amountSegments, [&](){
+                tessellateBezierChain( serial, chain, 10, isBernsteinChain, parallelVertices, offsets );
+                checksum += parallelVertices[7].getX();
+            } );
+            measure( isBernsteinChain ? "chainBern" : "chainCast", "store", store.size(), 12LL*amountSegments, [&](){
+                tessellateBezierChain( serial, store, 10, isBernsteinChain, parallelVertices, offsets );
+                checksum += parallelVertices[7].getX();
+            } );
+        }
+        tessellateBezierChain( serial, store, 10, true, parallelVertices, offsets );
+        if( memcmp( &serialVertices[0], &parallelVertices[0], serialVertices.size()*sizeof(vec3) ) != 0 ){
+            fail( "chain from the spline store differs from the chain of deques" );
+        }
+
+        // appends over several pages, without reserve(): the views taken before keep their points
+        splineStore paged;
+        paged.addCurve( chain[0] );
+        curveView first = paged[0];
+        const vec3 * firstPoints = first.data();
+        while( paged.getAmountPoints() < 3*splineStore::pageSize ){
+            paged.addCurve( chain[paged.size() % chain.size()] );
+        }
+        bool isPagedSame = paged[0].data() == firstPoints;
+        FOR(i,paged.size()){
+            curveView curve = paged[i];
+            const std::deque<vec3> & expected = chain[i % chain.size()];
+            isPagedSame = isPagedSame && curve.size() == (int)expected.size() && std::equal( expected.begin(), expected.end(), curve.begin() );
+        }
+        if( !isPagedSame ){
+            fail( "spline store moved or changed a curve while adding others" );
+        }
+
+        // float vertex buffer of the same chain (samples computed in double)
+        std::vector<vec3f> verticesF;
+        FOR(m,2){
+            bool isBernsteinChain = m == 0;
+            measure( isBernsteinChain ? "chainBernF" : "chainCastF", "store", store.size(), 12LL*amountSegments, [&](){
+                tessellateBezierChain( serial, store, 10, isBernsteinChain, verticesF, offsets );
+                checksum += verticesF[7].getX();
+            } );
+            tessellateBezierChain( serial, store, 10, isBernsteinChain, parallelVertices, offsets );
+            tessellateBezierChain( serial, store, 10, isBernsteinChain, verticesF, offsets );
+            checkFloatError( isBernsteinChain ? "chainBernF" : "chainCastF", "curves", store.size(), maxCoordinateError( parallelVertices, verticesF, parallelVertices.size() ),
+                             maxCoordinate( parallelVertices, parallelVertices.size() ) );
+        }
+    }
+
+    // chain of degree 6 curves (cached weights, one table fetched for the whole chain) against bernstein() per curve
+    {
+        splineStore store6;
+        std::deque<vec3> curve6 = benchControlPoints( 6 );
+        FOR(i,amountSegments){
+            FOR(j,7){
+                curve6[j] = curve6[j].addition( vec3( 6, 0, 0 ) );
+            }
+            store6.addCurve( curve6 );
+        }
+        std::vector<vec3> vertices6;
+        std::vector<int> offsets6;
+        FOR(t,4){
+            tessellationPool threads( amountThreads[t] );
+            measure( "chainBern6", "threads", amountThreads[t], 12LL*amountSegments, [&](){
+                tessellateBezierChain( threads, store6, 10, true, vertices6, offsets6 );
+                checksum += vertices6[7].getX();
+            } );
+        }
+        bool isSame = true;
+        FOR(i,amountSegments){
+            std::deque<vec3> reference = bernstein( store6[i].toDeque(), 10 );
+            FOR(s,12){
+                isSame = isSame && reference[s] == vertices6[offsets6[i]+s];
+            }
+        }
+        if( !isSame ){
+            fail( "chain of degree 6 curves differs from bernstein() per curve" );
+        }
+
+        // the cache holds at most its bytes, whatever the amount of tables
+        bernsteinBasisCache small( 1 << 20 );
+        size_t largest = 0;
+        FOR(k,20){
+            small.get( 20+k, 500 );
+            largest = small.getBytes() > largest ? small.getBytes() : largest;
+        }
+        if( largest > ( 1 << 20 ) ){
+            fail( "bernsteinBasisCache above its capacity in bytes" );
+        }
+        printf( "%-12s capacity %d bytes  tables %d  largest %lld bytes\n", "basisCache", 1 << 20, small.size(), (long long)largest );
+    }
+
+    // edit latency: one curve and its two neighbours recomputed out of the whole chain
+    {
+        tessellationPool threads( 1 );
+        tessellationCache cache;
+        cache.resize( chain.size() );
+        auto tessellate = [&]( int i, std::vector<vec3> & vertices ){
+            vertices.resize( 12 );
+            bernsteinBasisCache::shared().get( chain[i].size()-1, 10 )->evaluate( chain[i], &vertices[0] );
+        };
+        cache.update( threads, tessellate );
+        measure( "cacheFull", "curves", chain.size(), 12LL*chain.size(), [&](){ cache.markAllDirty(); cache.update( threads, tessellate ); } );
+        measure( "cacheEdit", "curves", chain.size(), 12LL*3, [&](){
+            FOR(k,3){
+                cache.markDirty( chain.size()/2 - 1 + k );
+            }
+            cache.update( threads, tessellate );
+        } );
+    }
+
+    // arc length tables: build, inverse lookup, and their error against a dense polyline
+    FOR(d,5){
+        std::deque<vec3> controlPoints = benchControlPoints( degrees[d] );
+        arcLengthTable table;
+        snprintf( parameter, sizeof(parameter), "deg%d/int", degrees[d] );
+        measure( "arcBuild", parameter, arcLengthTable::defaultIntervals, 1, [&](){ table.build( controlPoints ); checksum += table.getLength(); } );
+        int queries = 1000;
+        measure( "arcInverse", parameter, arcLengthTable::defaultIntervals, queries, [&](){
+            FOR(q,queries){
+                checksum += table.parameterAt( table.getLength()*q/(queries-1) );
+            }
+        } );
+        casteljauEvaluator evaluator( degrees[d] );
+        double polyline = 0;
+        vec3 previous = controlPoints[0];
+        FOR(i,100000){
+            vec3 point = evaluator.evaluate( (i+1)/100000., controlPoints );
+            polyline += ( point - previous ).norme();
+            previous = point;
+        }
+        double maxInverseError = 0;
+        FOR(q,queries){
+            double distance = table.getLength()*q/(queries-1);
+            maxInverseError = fmax( maxInverseError, fabs( table.lengthAt( table.parameterAt( distance ) ) - distance ) );
+        }
+        printf( "%-12s deg%-6d length %.10g polyline %.10g  inverse max error %.3g\n", "arcLength", degrees[d], table.getLength(), polyline, maxInverseError );
+    }
+    // equally spaced points along the whole chain, tables cached and after an edit of one curve
+    {
+        splineStore store;
+        FOR(i,chain.size()){
+            store.addCurve( chain[i] );
+        }
+        arcLengthCache tables;
+        std::vector<vec3> points( 12*store.size() );
+        sampleChainUniform( store, tables, points.size(), &points[0] );
+        measure( "arcChain", "cached", store.size(), points.size(), [&](){ sampleChainUniform( store, tables, points.size(), &points[0] ); checksum += points[7].getX(); } );
+        measure( "arcChain", "edit1", store.size(), points.size(), [&](){
+            tables.invalidate( store.size()/2 );
+            sampleChainUniform( store, tables, points.size(), &points[0] );
+            checksum += points[7].getX();
+        } );
+        measure( "arcChain", "rebuilt", store.size(), points.size(), [&](){
+            tables.invalidateAll();
+            sampleChainUniform( store, tables, points.size(), &points[0] );
+            checksum += points[7].getX();
+        } );
+        // spacing of the points on one curve (chords, slightly shorter than the arcs between them) against uniform u
+        splineStore single;
+        single.addCurve( chain[0] );
+        arcLengthCache singleTable;
+        std::vector<vec3> uniform( 1000 );
+        std::deque<vec3> uniformU = casteljau( chain[0], uniform.size()-2 );
+        sampleChainUniform( single, singleTable, uniform.size(), &uniform[0] );
+        double minChord = 1e300, maxChord = 0, minChordU = 1e300, maxChordU = 0;
+        FOR(i,uniform.size()-1){
+            double chord = ( uniform[i+1] - uniform[i] ).norme();
+            double chordU = ( uniformU[i+1] - uniformU[i] ).norme();
+            minChord = fmin( minChord, chord );
+            maxChord = fmax( maxChord, chord );
+            minChordU = fmin( minChordU, chordU );
+            maxChordU = fmax( maxChordU, chordU );
+        }
+        printf( "%-12s points %7d chord min %.6g max %.6g  (uniform u: min %.6g max %.6g)\n", "arcUniform", (int)uniform.size(), minChord, maxChord, minChordU, maxChordU );
+    }
+
+    // bounding volume hierarchy: picking and closest point queries on a scene of 1M cubic segments
+    {
+        int side = 1000;   // side x side cells of one segment each
+        splineStore scene;
+        scene.reserve( side*side, 4*side*side );
+        srand( 1 );
+        FOR(i,side*side){
+            vec3 origin( (i%side)*2, (i/side)*2, 0 );
+            vec3 points[4];
+            FOR(j,4){
+                points[j] = origin + vec3( rand()/(double)RAND_MAX*2, rand()/(double)RAND_MAX*2, 0 );
+            }
+            scene.addCurve( points, 4 );
+        }
+        curveBVH bvh;
+        measure( "bvhBuild", "segments", scene.size(), scene.size(), [&](){ bvh.build( scene ); checksum += bvh.getAmountNodes(); } );
+        std::vector<vec3> queries( 1000 );
+        FOR(q,queries.size()){
+            queries[q] = vec3( rand()/(double)RAND_MAX*2*side, rand()/(double)RAND_MAX*2*side, 0.5 );
+        }
+        int next = 0;
+        measure( "bvhNearest", "segments", scene.size(), 1, [&](){ checksum += bvh.nearestPoint( queries[next++ % queries.size()] ).distance; } );
+        measure( "bvhPickCurve", "segments", scene.size(), 1, [&](){ checksum += bvh.pickCurve( queries[next++ % queries.size()], 0.6 ).distance; } );
+        measure( "bvhPickPoint", "segments", scene.size(), 1, [&](){ checksum += bvh.pickControlPoint( queries[next++ % queries.size()], 0.6 ).distance; } );
+        measure( "bvhRefit", "segments", scene.size(), 1, [&](){
+            int curve = next++ % scene.size();
+            scene[curve][1] = scene[curve][1] + vec3( 0, 1e-3, 0 );
+            bvh.refit( curve );
+        } );
+
+        // against a dense sampling of every curve near the query (the sampling is never closer than the curve)
+        double maxDifference = 0;
+        casteljauEvaluator evaluator( 3 );
+        FOR(q,100){
+            curveHit hit = bvh.nearestPoint( queries[q] );
+            double brute = DBL_MAX;
+            int column = (int)( queries[q].getX()/2 ), row = (int)( queries[q].getY()/2 );
+            for( int r = row-2; r <= row+2; r++ ){
+                for( int c = column-2; c <= column+2; c++ ){
+                    if( r < 0 || c < 0 || r >= side || c >= side ){
+                        continue;
+                    }
+                    curveView curve = scene[r*side + c];
+                    FOR(i,2001){
+                        brute = fmin( brute, ( evaluator.evaluate( i/2000., curve ) - queries[q] ).norme() );
+                    }
+                }
+            }
+            maxDifference = fmax( maxDifference, fabs( brute - hit.distance ) );
+        }
+        printf( "%-12s segments %6d nodes %d  max difference with dense sampling %.3g\n", "bvhNearest", scene.size(), bvh.getAmountNodes(), maxDifference );
+    }
+
+    // curve-curve intersections of random curves (degrees 2 to 5) crossing each other in a square
+    int amountCrossing[] = { 300, 20000 };
+    FOR(s,2){
+        int amount = amountCrossing[s];
+        double side = sqrt( (double)amount )*2;   // about 4 other curves cross each curve
+        splineStore scene;
+        scene.reserve( amount, 6*amount );
+        srand( 2 );
+        FOR(i,amount){
+            int amountPoints = 3 + i%4;
+            vec3 origin( rand()/(double)RAND_MAX*side, rand()/(double)RAND_MAX*side, 0 );
+            vec3 points[6];
+            FOR(j,amountPoints){
+                points[j] = origin + vec3( rand()/(double)RAND_MAX*4 - 2, rand()/(double)RAND_MAX*4 - 2, 0 );
+            }
+            scene.addCurve( points, amountPoints );
+        }
+        curveBVH bvh;
+        bvh.build( scene );
+        std::vector<curveIntersection> intersections;
+        FOR(t,4){
+            tessellationPool threads( amountThreads[t] );
+            measure( "intersect", "threads", amountThreads[t], scene.size(), [&](){ intersectAll( threads, scene, bvh, intersections ); checksum += intersections.size(); } );
+        }
+        double maxGap = 0;
+        casteljauEvaluator evaluator3;
+        FOR(i,intersections.size()){
+            vec3 pointA = evaluator3.evaluate( intersections[i].tA, scene[intersections[i].curveA] );
+            vec3 pointB = evaluator3.evaluate( intersections[i].tB, scene[intersections[i].curveB] );
+            maxGap = fmax( maxGap, ( pointA - pointB ).norme() );
+        }
+        printf( "%-12s curves %6d intersections %d  max distance between the curves %.3g\n", "intersect", scene.size(), (int)intersections.size(), maxGap );
+
+        // every pair without the hierarchy
+        if( amount <= 300 ){
+            curveIntersector intersector;
+            std::vector<curveIntersection> brute;
+            FOR(a,amount){
+                for( int b = a+1; b < amount; b++ ){
+                    intersector.intersect( a, scene[a], b, scene[b], brute );
+                }
+            }
+            printf( "%-12s curves %6d intersections %d  all pairs %d\n", "intersect", scene.size(), (int)intersections.size(), (int)brute.size() );
+        }
+    }
+
+    // binary curve file of 1M curves (degrees 2 to 5): mapped and tessellated in place, compared with the store
+    {
+        const char * scenePath = "bench_scene.crv";
+        const char * tessellationPath = "bench_tessellation.crv";
+        int amount = 1000000;
+        splineStore scene;
+        scene.reserve( amount, 6*amount );
+        srand( 3 );
+        FOR(i,amount){
+            int amountPoints = 3 + i%4;
+            vec3 points[6];
+            FOR(j,amountPoints){
+                points[j] = vec3( i + rand()/(double)RAND_MAX, rand()/(double)RAND_MAX, rand()/(double)RAND_MAX );
+            }
+            scene.addCurve( points, amountPoints );
+        }
+        measure( "fileWrite", "curves", amount, amount, [&](){ checksum += writeCurveFile( scene, scenePath ); } );
+        measure( "fileOpen", "curves", amount, amount, [&](){
+            curveFileReader reader;
+            reader.open( scenePath );
+            checksum += reader.getAmountPoints();
+        } );
+        curveFileReader reader;
+        if( !reader.open( scenePath ) ){
+            printf( "%s can not be read back\n", scenePath );
+        }
+        else{
+            tessellationPool serial( 1 );
+            std::vector<vec3> storeVertices, fileVertices;
+            std::vector<int> storeOffsets, fileOffsets;
+            measure( "fileTess", "store", amount, 12LL*amount, [&](){ tessellateBezierChain( serial, scene, 10, true, storeVertices, storeOffsets ); checksum += storeVertices[7].getX(); } );
+            measure( "fileTess", "mapped", amount, 12LL*amount, [&](){ tessellateBezierChain( serial, reader, 10, true, fileVertices, fileOffsets ); checksum += fileVertices[7].getX(); } );
+            splineStore copy;
+            measure( "fileCopy", "curves", amount, amount, [&](){ copy.clear(); reader.copyTo( copy ); checksum += copy.getAmountPoints(); } );
+            splineStore viewed;
+            measure( "fileView", "curves", amount, amount, [&](){ viewed.clear(); reader.viewIn( viewed ); checksum += viewed.getAmountPoints(); } );
+            std::vector<vec3> viewedVertices;
+            std::vector<int> viewedOffsets;
+            tessellateBezierChain( serial, viewed, 10, true, viewedVertices, viewedOffsets );
+
+            // tessellated output streamed to a second file and read back
+            curveFileWriter writer;
+            measure( "fileStream", "vertices", amount, 12LL*amount, [&](){
+                writer.open( tessellationPath );
+                writer.addCurves( fileVertices.data(), fileOffsets.data(), amount );
+                checksum += writer.close();
+            } );
+            curveFileReader tessellation;
+            bool isSame = reader.size() == scene.size() && reader.getAmountPoints() == scene.getAmountPoints();
+            FOR(i,scene.size()){
+                isSame = isSame && reader[i].size() == scene[i].size() && memcmp( reader[i].data(), scene[i].data(), scene[i].size()*sizeof(vec3) ) == 0;
+            }
+            isSame = isSame && memcmp( fileVertices.data(), storeVertices.data(), storeVertices.size()*sizeof(vec3) ) == 0
+                       && tessellation.open( tessellationPath ) && tessellation.size() == amount
+                       && memcmp( tessellation[0].data(), fileVertices.data(), fileVertices.size()*sizeof(vec3) ) == 0
+                       && viewed[0].data() == reader[0].data() && viewedVertices == fileVertices;
+            printf( "%-12s curves %d points %lld  file and store %s\n", "fileTess", reader.size(), reader.getAmountPoints(), isSame ? "identical" : "DIFFER" );
+            if( !isSame ){
+                fail( "curve file read back differs from the store it was written from" );
+            }
+
+            // an edit through the views changes the mapping of this reader only, not the file
+            viewed[5][0] = vec3( -1, -1, -1 );
+            curveFileReader reopened;
+            if( !reopened.open( scenePath ) || reopened[5][0] != scene[5][0] || reader[5][0] != vec3( -1, -1, -1 ) ){
+                fail( "edit through a view of the mapped file reached the file or missed the mapping" );
+            }
+        }
+        reader.close();
+
+        // curves of fewer than 2 points: refused by the writer, and a file holding one (offsets[1] patched to 0) is rejected
+        {
+            vec3 points[4];
+            curveFileWriter writer;
+            bool isRefused = writer.open( tessellationPath ) && writer.addCurve( points, 0 ) == -1 && writer.addCurve( points, 1 ) == -1 && !writer.close();
+            writer.open( tessellationPath );
+            writer.addCurve( points, 2 );
+            writer.addCurve( points+2, 2 );
+            writer.close();
+            uint64_t emptyCurve = 0;
+            FILE * file = fopen( tessellationPath, "r+b" );
+            if( file != NULL ){
+                fseek( file, sizeof(curveFileHeader) + 4*sizeof(vec3) + 2*sizeof(curveRecord) + sizeof(uint64_t), SEEK_SET );
+                fwrite( &emptyCurve, sizeof(emptyCurve), 1, file );
+                fclose( file );
+            }
+            curveFileReader empty;
+            if( !isRefused || file == NULL || empty.open( tessellationPath ) ){
+                printf( "ERROR curves of fewer than 2 points written to or read from %s\n", tessellationPath );
+            }
+        }
+        remove( scenePath );
+        remove( tessellationPath );
+    }
+
+    // high degrees (fitted curves): O(n) rows of Bernstein weights against de Casteljau, elevation and
+    // reduction to cubic pieces
+    int highDegrees[] = { 50, 150, 400 };
+    FOR(d,3){
+        int degree = highDegrees[d];
+        std::deque<vec3> controlPoints;
+        FOR(i,degree+1){
+            controlPoints.push_back( vec3( i*0.01, sin( i*0.05 )*2 + sin( i*0.31 )*0.2, cos( i*0.03 ) ) );
+        }
+        splineStore single;
+        single.addCurve( controlPoints );
+        curveView curve = single[0];
+        highDegreeEvaluator high;
+        casteljauEvaluator reference( degree );
+        int next = 0;
+        measure( "highDegree", "degree", degree, 1, [&](){ checksum += high.evaluate( ( next++ % 1001 )/1000., curve ).getX(); } );
+        measure( "casteljauHD", "degree", degree, 1, [&](){ checksum += reference.evaluate( ( next++ % 1001 )/1000., curve ).getX(); } );
+        std::vector<vec3> exact( 1002 ), rows( 1002 );
+        FOR(s,1002){
+            exact[s] = reference.evaluate( s/1001., curve );
+        }
+        high.tessellate( curve, 1000, &rows[0] );
+        std::deque<vec3> basis = bernstein( controlPoints, 1000 );
+        printf( "%-12s degree %4d max error rows %.3g  basis %.3g  (against de Casteljau)\n", "highDegree", degree,
+                maxCoordinateError( exact, rows, exact.size() ), maxCoordinateError( exact, basis, exact.size() ) );
+
+        // elevated then reduced back: the same control points
+        std::vector<vec3> elevated( degree+2 ), reduced( degree+1 );
+        elevateDegree( curve.data(), degree+1, &elevated[0] );
+        double bound = reduceDegree( &elevated[0], degree+2, &reduced[0] );
+        printf( "%-12s degree %4d elevated and reduced: max difference %.3g bound %.3g\n", "elevate", degree, maxCoordinateError( curve, reduced, degree+1 ), bound );
+
+        // cubic pieces, checked at 21 parameters of each piece
+        degreeReducer reducer( 3, 1e-6 );
+        splineStore pieces;
+        std::vector<double> starts;
+        measure( "toCubics", "degree", degree, 1, [&](){ pieces.clear(); starts.clear(); checksum += reducer.convert( curve, pieces, &starts ); } );
+        starts.push_back( 1 );
+        double maxDistance = 0;
+        casteljauEvaluator cubic( 3 );
+        FOR(k,pieces.size()){
+            FOR(s,21){
+                double u = starts[k] + ( starts[k+1]-starts[k] )*s/20.;
+                maxDistance = fmax( maxDistance, ( cubic.evaluate( s/20., pieces[k] ) - reference.evaluate( u, curve ) ).norme() );
+            }
+        }
+        printf( "%-12s degree %4d pieces %d  max distance %.3g (tolerance 1e-6)\n", "toCubics", degree, pieces.size(), maxDistance );
+    }
+
+    // C1 and C2 over a chain of 100k cubic segments: whole chain, then one joint moved in the middle
+    {
+        int amount = 100000;
+        splineStore chainStore;
+        chainStore.reserve( amount, 4*amount );
+        srand( 4 );
+        vec3 joint( 0, 0, 0 );
+        FOR(i,amount){
+            vec3 points[4];
+            points[0] = joint;
+            FOR(j,3){
+                points[j+1] = joint + vec3( j+1, rand()/(double)RAND_MAX*2 - 1, 0 );
+            }
+            joint = points[3];
+            chainStore.addCurve( points, 4 );
+        }
+        measure( "chainC1", "curves", amount, amount, [&](){ enforceC1( chainStore ); checksum += chainStore[amount/2][1].getY(); } );
+        splineChainSolver solver;
+        measure( "chainC2", "curves", amount, amount, [&](){ solver.solve( chainStore ); checksum += chainStore[amount/2][1].getY(); } );
+        int first = 0, last = 0, edits = 0;
+        measure( "chainC2Move", "curves", amount, 1, [&](){
+            int knot = amount/2 + ( edits++ % 1000 ) - 500;
+            solver.moveKnot( chainStore, knot, solver.getKnot( knot ) + vec3( 0, ( edits % 2 ) ? 0.1 : -0.1, 0 ), first, last );
+            checksum += chainStore[knot][1].getY();
+        } );
+
+        // second derivatives at the joints, and the edited chain against the chain solved again from its joints
+        double maxJump = 0;
+        for( int i = 1; i < amount; i++ ){
+            curveView a = chainStore[i-1], b = chainStore[i];
+            maxJump = fmax( maxJump, ( ( a[1] - a[2]*2. + a[3] ) - ( b[0] - b[1]*2. + b[2] ) ).norme()*6 );
+        }
+        splineStore resolved;
+        resolved.reserve( amount, 4*amount );
+        FOR(i,amount){
+            resolved.addCurve( chainStore[i].data(), 4 );
+        }
+        splineChainSolver reference;
+        reference.solve( resolved );
+        double maxDifference = 0;
+        FOR(i,amount){
+            maxDifference = fmax( maxDifference, maxCoordinateError( resolved[i].data(), chainStore[i].data(), 4 ) );
+        }
+        printf( "%-12s curves %d  last edit wrote %d curves  max jump of C'' %.3g  max difference with a full solve %.3g\n", "chainC2Move",
+                amount, last-first+1, maxJump, maxDifference );
+    }
+
+    // Catmull-Rom spline through 1M points: tangents in bulk, then 10 samples per segment
+    {
+        int amount = 1000000, samplesPerSegment = 10;
+        std::vector<vec3> walk( amount );
+        srand( 5 );
+        vec3 position( 0, 0, 0 );
+        FOR(i,amount){
+            position += vec3( rand()/(double)RAND_MAX*2 - 1, rand()/(double)RAND_MAX*2 - 1, rand()/(double)RAND_MAX*2 - 1 );
+            walk[i] = position;
+        }
+        splineStore pathStore;
+        pathStore.addCurve( &walk[0], amount );
+        curveView path = pathStore[0];
+        hermiteSpline spline;
+        measure( "splineBuild", "points", amount, amount, [&](){ spline.build( path ); checksum += spline.getOutgoing( amount/2 ).getX(); } );
+        std::vector<vec3> samples;
+        FOR(t,4){
+            tessellationPool threads( amountThreads[t] );
+            spline.build( threads, path );
+            measure( "splineSample", "threads", amountThreads[t], spline.getAmountSamples( samplesPerSegment ), [&](){
+                spline.sample( threads, samplesPerSegment, samples );
+                checksum += samples[7].getX();
+            } );
+        }
+
+        // against hermite() on each segment, and the samples at the points
+        double maxError = 0;
+        bool isThroughPoints = true;
+        FOR(i,amount-1){
+            FOR(s,samplesPerSegment){
+                vec3 exact = hermite<double>( s/(double)samplesPerSegment, path[i], path[i+1], spline.getOutgoing( i ), spline.getIncoming( i+1 ) );
+                maxError = fmax( maxError, ( exact - samples[(long long)i*samplesPerSegment + s] ).norme() );
+            }
+            isThroughPoints = isThroughPoints && samples[(long long)i*samplesPerSegment] == path[i];
+        }
+        isThroughPoints = isThroughPoints && samples.back() == path[amount-1];
+        printf( "%-12s points %d  max error %.3g (against hermite)  samples through the points: %s\n", "splineSample",
+                amount, maxError, isThroughPoints ? "yes" : "no" );
+    }
+
+    // adaptive tessellation against the fixed amountSamples (vertices per curve)
+    double tolerances[] = { 0.1, 0.01, 0.001 };
+    FOR(d,5){
+        std::deque<vec3> controlPoints = benchControlPoints( degrees[d] );
+        adaptiveTessellator tessellator;
+        std::vector<vec3> vertices;
+        FOR(t,3){
+            tessellator.setTolerance( tolerances[t] );
+            tessellator.tessellate( controlPoints, vertices );
+            snprintf( parameter, sizeof(parameter), "deg%d/tol", degrees[d] );
+            int amountVertices = vertices.size();
+            measure( "adaptive", parameter, amountVertices, amountVertices, [&](){ tessellator.tessellate( controlPoints, vertices ); checksum += vertices[1].getX(); } );
+        }
+    }
+    // mostly straight segment: the fixed tessellation uses 12 vertices
+    std::deque<vec3> straight;
+    FOR(j,4){
+        straight.push_back( vec3( j, 0.001*j*j, 0 ) );
+    }
+    printf( "%-12s straight cubic at 0.01: %d vertices (fixed: 12)\n", "adaptive", (int)adaptive( straight, 0.01 ).size() );
+
+    // casteljau subdivision at u = 0.5 (one split per sample)
+    FOR(d,5){
+        std::deque<vec3> controlPoints = benchControlPoints( degrees[d] );
+        std::deque<vec3> left, right;
+        casteljauEvaluator evaluator( degrees[d] );
+        measure( "subdivide", "degree", degrees[d], 1, [&](){
+            evaluator.subdivide( 0.5, controlPoints, left, right );
+            checksum += left[1].getX() + right[1].getX();
+        } );
+    }
+
+    // chaikin (closed polygon of 6 points, as in main.Subdivis.cpp)
+    std::deque<vec3> polygon;
+    polygon.push_back( vec3( -2,0,0 ) );
+    polygon.push_back( vec3( 0,3,0 ) );
+    polygon.push_back( vec3( 3,3,0 ) );
+    polygon.push_back( vec3( 1,0,0 ) );
+    polygon.push_back( vec3( 3,-3,0 ) );
+    polygon.push_back( vec3( 0,-3,0 ) );
+    for( int level = 1; level <= 8; level++ ){
+        measure( "chaikin", "levels", level, (long long)polygon.size() << level, [&](){ consume( chaikin( polygon, 0, level ) ); } );
+    }
+
+    // chaikin with the ping-pong buffers of chaikinEngine (output kept between runs)
+    chaikinEngine engine;
+    std::vector<vec3> subdivided;
+    for( int level = 1; level <= 8; level++ ){
+        measure( "chaikinPP", "levels", level, (long long)polygon.size() << level, [&](){ engine.subdivide( polygon, level, subdivided ); checksum += subdivided[0].getX(); } );
+    }
+    // same ping-pong buffers in float, and the error of the deepest level against the double path
+    chaikinEngineF engineF;
+    std::deque<vec3f> polygonF = toFloat( polygon );
+    std::vector<vec3f> subdividedF;
+    for( int level = 2; level <= 8; level += 2 ){
+        measure( "chaikinPPF", "levels", level, (long long)polygon.size() << level, [&](){ engineF.subdivide( polygonF, level, subdividedF ); checksum += subdividedF[0].getX(); } );
+    }
+    engine.subdivide( polygon, 8, subdivided );
+    checkFloatError( "chaikinPPF", "levels", 8, maxCoordinateError( subdivided, subdividedF, subdivided.size() ) );
+    // large polygon
+    std::deque<vec3> outline;
+    FOR(i,10000){
+        outline.push_back( vec3( cos( i*0.000628 )*(3 + sin( i*0.05 )), sin( i*0.000628 )*3, 0 ) );
+    }
+    for( int level = 1; level <= 5; level += 2 ){
+        measure( "chaikin10k", "levels", level, (long long)outline.size() << level, [&](){ consume( chaikin( outline, 0, level ) ); } );
+        measure( "chaikinPP10k", "levels", level, (long long)outline.size() << level, [&](){ engine.subdivide( outline, level, subdivided ); checksum += subdivided[0].getX(); } );
+    }
+
+    // subdivision schemes with compile-time stencils (closed polygon of 6 points)
+    subdivisionEngine<chaikinStencil> chaikinSchemeEngine;
+    subdivisionEngine< laneRiesenfeldStencil<3> > cubicSchemeEngine;
+    subdivisionEngine< laneRiesenfeldStencil<5> > quinticSchemeEngine;
+    subdivisionEngine<fourPointStencil> fourPointSchemeEngine;
+    for( int level = 2; level <= 8; level += 2 ){
+        long long amount = (long long)polygon.size() << level;
+        measure( "stencilChk", "levels", level, amount, [&](){ checksum += chaikinSchemeEngine.subdivide( polygon, true, level )[0].getX(); } );
+        measure( "stencilLR3", "levels", level, amount, [&](){ checksum += cubicSchemeEngine.subdivide( polygon, true, level )[0].getX(); } );
+        measure( "stencilLR5", "levels", level, amount, [&](){ checksum += quinticSchemeEngine.subdivide( polygon, true, level )[0].getX(); } );
+        measure( "stencil4pt", "levels", level, amount, [&](){ checksum += fourPointSchemeEngine.subdivide( polygon, true, level )[0].getX(); } );
+    }
+    // the same stencils in float
+    subdivisionEngine< laneRiesenfeldStencil<3>, float > cubicSchemeEngineF;
+    subdivisionEngine< fourPointStencil, float > fourPointSchemeEngineF;
+    measure( "stencilLR3F", "levels", 8, (long long)polygon.size() << 8, [&](){ checksum += cubicSchemeEngineF.subdivide( polygonF, true, 8 )[0].getX(); } );
+    measure( "stencil4ptF", "levels", 8, (long long)polygon.size() << 8, [&](){ checksum += fourPointSchemeEngineF.subdivide( polygonF, true, 8 )[0].getX(); } );
+    {
+        std::vector<vec3> & cubic = cubicSchemeEngine.subdivide( polygon, true, 8 );
+        std::vector<vec3> & fourPoint = fourPointSchemeEngine.subdivide( polygon, true, 8 );
+        checkFloatError( "stencilLR3F", "levels", 8, maxCoordinateError( cubic, cubicSchemeEngineF.subdivide( polygonF, true, 8 ), cubic.size() ) );
+        checkFloatError( "stencil4ptF", "levels", 8, maxCoordinateError( fourPoint, fourPointSchemeEngineF.subdivide( polygonF, true, 8 ), fourPoint.size() ) );
+    }
+
+    // streamed chaikin (no level held in memory) against the materialized levels
+    for( int level = 4; level <= 16; level += 4 ){
+        long long amount = (long long)polygon.size() << level;
+        measure( "chaikinStrm", "levels", level, amount, [&](){
+            chaikinStream stream( polygon, level );
+            vec3 point;
+            while( stream.next( point ) ){
+                checksum += point.getX();
+            }
+        } );
+        if( level <= 12 ){
+            measure( "chaikinPP", "levels", level, amount, [&](){ engine.subdivide( polygon, level, subdivided ); checksum += subdivided[0].getX(); } );
+        }
+    }
+
+    // one control point moved on a 100k points outline: full subdivision against the local update
+    std::deque<vec3> bigOutline;
+    FOR(i,100000){
+        bigOutline.push_back( vec3( cos( i*0.0000628 )*3, sin( i*0.0000628 )*3, 0 ) );
+    }
+    chaikinIncremental incremental;
+    incremental.build( bigOutline, 5 );
+    measure( "chaikinFull", "edit", 100000, 100000LL << 5, [&](){ engine.subdivide( bigOutline, 5, subdivided ); checksum += subdivided[0].getX(); } );
+    int moved = 0;
+    measure( "chaikinLocal", "edit", 100000, 1, [&](){
+        moved = (moved + 7919) % 100000;
+        incremental.update( moved, bigOutline[moved].addition( vec3( 0.01, 0, 0 ) ) );
+        checksum += incremental.getResult()[0].getX();
+    } );
+
+    // edits at both ends (the windows wrap around) and inside: the kept levels against a full subdivision
+    {
+        std::deque<vec3> edited = bigOutline;
+        chaikinIncremental local;
+        local.build( edited, 5 );
+        int edits[] = { 0, 99999, 1, 500, 50000, 99998 };
+        FOR(e,6){
+            edited[edits[e]] = edited[edits[e]].addition( vec3( 0.01*(e+1), -0.02, 0 ) );
+            local.update( edits[e], edited[edits[e]] );
+        }
+        engine.subdivide( edited, 5, subdivided );
+        std::vector<vec3> & result = local.getResult();
+        if( result.size() != subdivided.size() || memcmp( &result[0], &subdivided[0], result.size()*sizeof(vec3) ) != 0 ){
+            fail( "chaikinIncremental::update differs from the full subdivision of the edited polygon" );
+        }
+        else{
+            printf( "%-12s edits %d  identical to the full subdivision\n", "chaikinLocal", 6 );
+        }
+    }
+
+    // incremental and streamed chaikin in float, against the double path after the same edit
+    {
+        std::deque<vec3f> bigOutlineF = toFloat( bigOutline );
+        chaikinIncremental reference;
+        chaikinIncrementalF incrementalF;
+        reference.build( bigOutline, 5 );
+        incrementalF.build( bigOutlineF, 5 );
+        reference.update( 500, bigOutline[500].addition( vec3( 0.01, 0, 0 ) ) );
+        incrementalF.update( 500, vec3f( bigOutline[500].addition( vec3( 0.01, 0, 0 ) ) ) );
+        checkFloatError( "chaikinLocF", "levels", 5, maxCoordinateError( reference.getResult(), incrementalF.getResult(), reference.getResult().size() ) );
+
+        engine.subdivide( polygon, 8, subdivided );
+        chaikinStreamF streamF( polygonF, 8 );
+        vec3f pointF;
+        double maxError = 0;
+        for( int i = 0; streamF.next( pointF ); i++ ){
+            maxError = fmax( maxError, fabs( pointF.getX() - subdivided[i].getX() ) );
+            maxError = fmax( maxError, fabs( pointF.getY() - subdivided[i].getY() ) );
+            maxError = fmax( maxError, fabs( pointF.getZ() - subdivided[i].getZ() ) );
+        }
+        checkFloatError( "chaikinStrmF", "levels", 8, maxError );
+    }
+
+    // cost of one timed scope with one counter (nothing unless built with -DCURVES_PROFILE=ON)
+    measure( "profile", profiler::isEnabled() ? "enabled" : "disabled", 1, 1, [&](){
+        PROFILE_SCOPE( timerBernstein );
+        PROFILE_COUNT( counterSamples, 1 );
+        checksum += 1;
+    } );
+    // counters of one frame of 1000 cubic curves tessellated from the deques
+    if( profiler::isEnabled() ){
+        profiler::shared().endFrame();
+        std::deque<vec3> frameCurve = benchControlPoints( 3 );
+        FOR(i,1000){
+            checksum += bernstein( frameCurve, 10 )[3].getX();
+        }
+        profiler::shared().endFrame();
+        printf( "%-12s frame bernstein %.3f ms samples %lld allocations %lld basis hits %lld misses %lld\n", "profile",
+                profiler::shared().getLastTime( timerBernstein )*1e-6, profiler::shared().getLastCount( counterSamples ), profiler::shared().getLastCount( counterAllocations ),
+                profiler::shared().getLastCount( counterBasisHits ), profiler::shared().getLastCount( counterBasisMisses ) );
+    }
+
+    printf( "checksum %g\n", checksum );
+    if( failures > 0 ){
+        printf( "ERROR %d checks failed\n", failures );
+        return 1;
+    }
+    return 0;
+}
@@ -6,10 +6,23 @@
  *   q :  gauche
  *   z : en haut
  *   s : en bas
+ *   f : active/dsactive les diffrences avances (segments cubiques)
+ *   h : active/dsactive la base monomiale value par Horner
+ *   a : active/dsactive la subdivision adaptative (tolrance en pixels)
+ *   + / - : ajoute/retire un thread de calcul des courbes
+ *   clic gauche : slectionne le point de controle (ou la courbe) sous le curseur
+ *   l : affiche/masque des points espacs rgulirement en longueur d'arc le long de la chane
+ *   p : affiche/masque les temps et compteurs de la dernire image (compil avec -DCURVES_PROFILE=ON)
+ *   j : crit les temps, compteurs et histogrammes dans profile.json
+ *   k : affiche/masque la spline de Catmull-Rom passant par les jonctions de la chane
+ *   c : continuit C1 (voisins du point dplac) ou C2 (spline cubique interpolant les jonctions, P1 et P2 dplacent la jonction voisine)
+ * M_TP05_Curves fichier.crv : charge les courbes d'un fichier binaire (curveFile.h) au lieu de la chane par dfaut
  *
  */
 
+ #ifdef _WIN32
  #include <windows.h>
+ #endif
 
 #include <GL/glut.h>
 #include <GL/glu.h>
@@ -20,6 +33,22 @@
 #include "struct.h"
 #include "vec3.h"
 #include "utils.h"
+#include "curves.h"
+#include "forwardDifferences.h"
+#include "powerBasis.h"
+#include "bernsteinBasis.h"
+#include "bezierFixed.h"
+#include "casteljau.h"
+#include "parallelTessellation.h"
+#include "adaptiveTessellation.h"
+#include "tessellationCache.h"
+#include "splineStore.h"
+#include "arcLength.h"
+#include "curveBVH.h"
+#include "curveFile.h"
+#include "profiler.h"
+#include "splineChain.h"
+#include "hermiteSpline.h"
 
 /* au cas ou M_PI ne soit defini */
 #ifndef M_PI
@@ -29,7 +58,18 @@
 #define ESC 27
 
 int nCurves = 3;            // Amount of curves
+const char * scenePath = NULL;     // curve file given on the command line, replaces the default chain
+int amountSamples = 10;     // Samples of each curve
 bool isBernstein = true;   // Bernstein or Casteljau
+bool isForwardDifferences = false;  // cubic segments tessellated with forward differences (key f)
+bool isHorner = false;     // segments converted to the power basis and evaluated with Horner (key h)
+bool isAdaptive = false;   // segments split until flat instead of amountSamples (key a)
+double adaptiveTolerancePixels = 0.5;   // distance allowed between the curve and its vertices, in pixels
+bool isArcLengthPoints = false;    // points at constant arc length along the chain (key l)
+int amountArcLengthPoints = 60;
+bool isC2 = false;                 // C2 spline through the joints instead of C1 around the edited point (key c)
+bool isCatmullRom = false;         // Catmull-Rom spline through the joints of the chain (key k)
+bool isProfileOverlay = false;     // timers and counters of the last frame drawn over the curves (key p)
 
 float tx=0.0;
 float ty=0.0;
@@ -45,121 +85,40 @@ vec3 p3( 2,-2,0 );
 vec3 p4( 0,2,0 );
 vec3 v1( 1,5,0 );
 vec3 v2( 1,-5,0 );
-std::deque< std::deque<vec3> > bernsteinControlVertices;
-int maxFactorial = 100;
-double * factorial;
-
-// calculate the position on the curve between P1 and P2 (and the tangent on these points) related to the factor u [0,1]
-vec3 hermite( double u, vec3 p1, vec3 p2, vec3 v1, vec3 v2 ){
-    // Factor that represents the importance of each point and tangent to the result
-    double importP1 = 2*pow(u,3) -3*pow(u,2) +1;
-    double importP2 = -2*pow(u,3) +3*pow(u,2);
-    double importV1 = pow(u,3) -2*pow(u,2) + u;
-    double importV2 = pow(u,3) -pow(u,2);
-
-    // position = iP1*P1 +  iP2*P2 +  iV1*V1 +  iV2*V2
-    return p1.multiplication( importP1 ).addition(
-        p2.multiplication( importP2 ).addition(
-        v1.multiplication( importV1 ).addition(
-        v2.multiplication( importV2 )
-        )));
-}
-
-// calculate the curve between P1 and P2 (and the tangent on these points). amountSamples defines the amount of samples in the curve
-std::deque<vec3> hermite( vec3 p1, vec3 p2, vec3 v1, vec3 v2, int amountSamples ){
-    int amount = amountSamples+2;   // at least 2 samples will be created
-    std::deque<vec3> result;
-    for( int i=0; i<amount; i++ ){
-        result.push_back( hermite( i/((double)amount-1), p1, p2, v1, v2 ) );
-    }
-    return result;
-}
-
-// obtains the factorial in the matrix. if it does not exist, create it
-double getFactorial( int n ){
-    if( factorial[n] != 0 ){
-        return factorial[n];
-    }
-    else{
-        factorial[n] = n*getFactorial( n-1 );
-        return factorial[n];
-    }
-}
-
-// obtains the bernsteinB
-double getBernsteinB( int n, int i, double t ){
-    return (getFactorial( n )/(getFactorial( i )*getFactorial( n-i )))*pow(t,i) * pow(1-t,n-i);
-}
-
-// calculate the position on the Bezier curve (Bernstein) related to the factor u [0,1]
-vec3 bernstein( double u, std::deque<vec3> controlPoints ){
-    // initializing the result with the first point
-    vec3 result = controlPoints[0].multiplication( getBernsteinB( controlPoints.size()-1, 0, u ) );
-    for( int i = 1; i<controlPoints.size(); i++ ){
-        result = result.addition( controlPoints[i].multiplication( getBernsteinB( controlPoints.size()-1, i, u ) ) );
-    }
-    return result;
-}
-
-// calculate the Bezier curve based on Bernstein algorithm. amountSamples defines the amount of samples in the curve
-std::deque<vec3> bernstein( std::deque<vec3> controlPoints, int amountSamples ){
-    int amount = amountSamples+2;   // at least 2 samples will be created
-    std::deque<vec3> result;
-    for( int i=0; i<amount; i++ ){
-        result.push_back( bernstein( i/((double)amount-1), controlPoints ) );
-    }
-    return result;
-}
-
-// Set the position of the point 1 to the point 2
-void adjustContinuity( vec3 * controlPoint1, vec3 * controlPoint2 ){
-    controlPoint2->setX(controlPoint1->getX());
-    controlPoint2->setY(controlPoint1->getY());
-    controlPoint2->setZ(controlPoint1->getZ());
-}
-
-// Set the inverse of the position of the point 1 to the point 2 (relative to the center)
-void adjustContinuityTangent( vec3 * centerPoint, vec3 * controlPoint1, vec3 * controlPoint2 ){
-    vec3 distance = controlPoint1->soustraction( *centerPoint );
-
-    controlPoint2->setX(centerPoint->getX()-distance.getX());
-    controlPoint2->setY(centerPoint->getY()-distance.getY());
-    controlPoint2->setZ(centerPoint->getZ()-distance.getZ());
-}
-
-// calculate the intermediate k position on the Bezier curve (Casteljau) related to the factor u [0,1]
-vec3 casteljauP( double u, int k, int i, std::deque<vec3> controlPoints ){
-    if( k == 0 ){
-        return controlPoints[i];
-    }
-    else{
-        return casteljauP( u, k-1, i, controlPoints ).multiplication( 1-u ).addition( casteljauP( u, k-1, i+1, controlPoints ).multiplication( u ) );
-    }
-}
-
-// calculate the Bezier curve based on Casteljau algorithm. amountSamples defines the amount of samples in the curve
-std::deque<vec3> casteljau( std::deque<vec3> controlPoints, int amountSamples ){
-    int amount = amountSamples+2;   // at least 2 samples will be created
-    std::deque<vec3> result;
-    for( int i=0; i<amount; i++ ){
-        result.push_back( casteljauP( i/((double)amount-1), controlPoints.size()-1, 0, controlPoints ) );
-    }
-    return result;
-}
+splineStore bernsteinControlVertices;     // control points of every curve in one array, read through curveViews
+curveFileReader scene;             // mapped file of the command line, bernsteinControlVertices views its points
+powerBasisCache powerSegments;     // power basis of each curve, invalidated when keyboard() moves a point (invalidateCurve)
+int tessellationThreads = 0;       // threads calculating the curves, 0 for one per core (keys + and -)
+tessellationPool * pool = NULL;
+tessellationCache bezierCurves;    // vertices of each curve, recomputed only when marked dirty
+tessellationCache hermiteCurves;
+curveBVH curveIndex;               // boxes of the curves for the mouse picking, refitted by invalidateCurve
+arcLengthCache arcLengths;         // arc length table of each curve, invalidated only when keyboard() moves a point
+splineChainSolver chainSolver;     // tangents of the C2 chain, updated around the moved joint
+
+double orthoLeft = -3, orthoRight = 11, orthoBottom = -7, orthoTop = 7;   // glOrtho of reshape()
+int viewportWidth = 400, viewportHeight = 400;
 
 /* initialisation d'OpenGL*/
 static void init(void)
 {
 	glClearColor(0.0, 0.0, 0.0, 0.0);
 
-	// cleaning factorial matrix
-	factorial = new double[maxFactorial];
-	FOR(i,maxFactorial){
-        factorial[i] = 0;
+	pool = new tessellationPool( tessellationThreads );
+
+	// curves of the file, viewed in place: keyboard() edits copy only the pages they write
+	if( scenePath != NULL ){
+		if( scene.open( scenePath ) && scene.size() > 0 ){
+			scene.viewIn( bernsteinControlVertices );
+			nCurves = bernsteinControlVertices.size();
+			curveIndex.build( bernsteinControlVertices );
+			return;
+		}
+		printf( "%s is not a curve file or has no curves, using the default curves\n", scenePath );
 	}
-	factorial[0] = 1;
 
 	// setting bernstein control vertices
+	bernsteinControlVertices.reserve( nCurves, 4*nCurves );
 	FOR(i,nCurves)
 	{
         std::deque<vec3> controlPoints;
@@ -172,7 +131,7 @@ static void init(void)
         controlPoints.push_back( p2.addition( translate ).addition( translateInverse ) );
         controlPoints.push_back( p3.addition( translate ) );
 
-        bernsteinControlVertices.push_back( controlPoints );
+        bernsteinControlVertices.addCurve( controlPoints );
 
         // adjust continuity
         if( i > 0 ){
@@ -180,16 +139,94 @@ static void init(void)
             adjustContinuityTangent( &bernsteinControlVertices[i-1][bernsteinControlVertices[i-1].size()-1], &bernsteinControlVertices[i-1][bernsteinControlVertices[i-1].size()-2], &bernsteinControlVertices[i][1] );
         }
 	}
+	curveIndex.build( bernsteinControlVertices );
+}
+
+// invalidates everything calculated from the control points of the curve
+void invalidateCurve( int curve ){
+    powerSegments.invalidate( curve );
+    bezierCurves.markDirty( curve );
+    hermiteCurves.markDirty( curve );
+    arcLengths.invalidate( curve );
+    curveIndex.refit( curve );
+}
+
+void invalidateCurves( int first, int last ){
+    for( int i = first; i <= last; i++ ){
+        invalidateCurve( i );
+    }
+}
+
+void invalidateAllCurves(){
+    powerSegments.invalidateAll();
+    bezierCurves.markAllDirty();
+    hermiteCurves.markAllDirty();
 }
 
-void drawCurve(std::deque<vec3> bernsteinVertices, std::deque<vec3> controlPoints, bool isSelected){
-    // calculate hermite curve
-	std::deque<vec3> hermiteVertices = hermite( controlPoints[0],
-                                                controlPoints[3],
-                                                controlPoints[1].soustraction( controlPoints[0] ),
-                                                controlPoints[controlPoints.size()-1].soustraction( controlPoints[controlPoints.size()-2] ),
-                                                10
-                                                );
+// calculate the hermite curve of the control points (tangents from the control polygon)
+void tessellateHermite( curveView controlPoints, std::vector<vec3> & vertices ){
+    if( controlPoints.size() < 2 ){
+        vertices.clear();   // no tangent
+        return;
+    }
+    vertices.resize( amountSamples+2 );
+    vec3 tangent1 = controlPoints[1].soustraction( controlPoints[0] );
+    vec3 tangent2 = controlPoints[controlPoints.size()-1].soustraction( controlPoints[controlPoints.size()-2] );
+    vec3 last = controlPoints[controlPoints.size()-1];     // curves of a file are not all cubic
+    PROFILE_COUNT( counterSamples, amountSamples+2 );
+    if( isForwardDifferences ){
+        PROFILE_SCOPE( timerForwardDifferences );
+        forwardDifferences segment;
+        segment.setHermite( controlPoints[0], last, tangent1, tangent2 );
+        segment.tessellate( amountSamples, &vertices[0] );
+    }else{
+        PROFILE_SCOPE( timerHermite );
+        for( int s = 0; s < amountSamples+2; s++ ){
+            vertices[s] = hermite( s/((double)amountSamples+1), controlPoints[0], last, tangent1, tangent2 );
+        }
+    }
+}
+
+// calculate the bezier curve i with the selected algorithm
+void tessellateBezier( int i, std::vector<vec3> & vertices ){
+    curveView controlPoints = bernsteinControlVertices[i];
+    if( isAdaptive ){
+        // split the curve until it is flat within adaptiveTolerancePixels of the current glOrtho mapping
+        PROFILE_SCOPE( timerAdaptive );
+        adaptiveTessellator tessellator( pixelsToWorld( adaptiveTolerancePixels, orthoLeft, orthoRight, orthoBottom, orthoTop, viewportWidth, viewportHeight ) );
+        tessellator.tessellate( controlPoints, vertices );
+        PROFILE_COUNT( counterSamples, vertices.size() );
+        return;
+    }
+
+    vertices.resize( amountSamples+2 );
+    PROFILE_COUNT( counterSamples, amountSamples+2 );
+    if( isForwardDifferences && controlPoints.size() == 4 ){
+        // calculate cubic bezier curve (forward differences)
+        PROFILE_SCOPE( timerForwardDifferences );
+        forwardDifferences segment;
+        segment.setBezier( controlPoints[0], controlPoints[1], controlPoints[2], controlPoints[3] );
+        segment.tessellate( amountSamples, &vertices[0] );
+    }else if( isHorner ){
+        // calculate bezier curve (power basis, horner)
+        PROFILE_SCOPE( timerPowerBasis );
+        powerSegments.get( i, controlPoints ).tessellate( amountSamples, &vertices[0] );
+    }else if( isBernstein ){
+        //calculate bezier curve (bernstein, degree fixed at compile time for the common degrees)
+        PROFILE_SCOPE( timerBernstein );
+        bernsteinDispatch( controlPoints, amountSamples, &vertices[0] );
+    }else{
+        // calculate bezier curve (casteljau)
+        PROFILE_SCOPE( timerCasteljau );
+        casteljauEvaluator evaluator( controlPoints.size()-1 );
+        for( int s = 0; s < amountSamples+2; s++ ){
+            vertices[s] = evaluator.evaluate( s/((double)amountSamples+1), controlPoints );
+        }
+    }
+}
+
+void drawCurve(std::vector<vec3> & hermiteVertices, std::vector<vec3> & bernsteinVertices, curveView controlPoints, bool isSelected){
+	PROFILE_COUNT( counterVerticesSubmitted, hermiteVertices.size() + controlPoints.size() + bernsteinVertices.size() + (isSelected ? 4 : 0) );
 
 	// Print Hermite Curve
 	glBegin(GL_LINE_STRIP);
@@ -233,32 +270,106 @@ void drawCurve(std::deque<vec3> bernsteinVertices, std::deque<vec3> controlPoint
 }
 
 /* Dessine de la courbe */
-void display(void)
-{
+// one line of text per timer and counter, from the top left corner of the view
+void drawProfile(){
+    if( !profiler::isEnabled() ){
+        return;
+    }
+    std::string text = profiler::shared().summary();
+    double lineHeight = 13*(orthoTop-orthoBottom)/viewportHeight;
+    double y = orthoTop - lineHeight;
+    glColor3f(0.7,0.7,0.7);
+    glRasterPos2d( orthoLeft + lineHeight/2, y );
+    for( int i = 0; i < text.size(); i++ ){
+        if( text[i] == '\n' ){
+            y -= lineHeight;
+            glRasterPos2d( orthoLeft + lineHeight/2, y );
+        }else{
+            glutBitmapCharacter( GLUT_BITMAP_8_BY_13, text[i] );
+        }
+    }
+}
+
+// tessellates the edited curves and draws every curve
+void drawScene(){
 	glClear(GL_COLOR_BUFFER_BIT);
 
 	glMatrixMode(GL_MODELVIEW);
 	glLoadIdentity();
 
+	// recalculate in parallel only the curves changed since the last frame
+	powerSegments.resize( bernsteinControlVertices.size() );
+	bezierCurves.resize( bernsteinControlVertices.size() );
+	hermiteCurves.resize( bernsteinControlVertices.size() );
+	{
+        PROFILE_SCOPE( timerUpdateBezier );
+        bezierCurves.update( *pool, tessellateBezier );
+	}
+	{
+        PROFILE_SCOPE( timerUpdateHermite );
+        hermiteCurves.update( *pool, [&]( int i, std::vector<vec3> & vertices ){
+            tessellateHermite( bernsteinControlVertices[i], vertices );
+        } );
+	}
+
+	// draw the curves in order
 	FOR(i,bernsteinControlVertices.size()){
-        // adjust continuity
-        // HERE it blocks modifications on the begin of the curves
-        /*if( i > 0 ){
-            adjustContinuity( &bernsteinControlVertices[i-1][bernsteinControlVertices[i-1].size()-1], &bernsteinControlVertices[i][0] );
-            adjustContinuityTangent( &bernsteinControlVertices[i-1][bernsteinControlVertices[i-1].size()-1], &bernsteinControlVertices[i-1][bernsteinControlVertices[i-1].size()-2], &bernsteinControlVertices[i][1] );
-        }*/
+        PROFILE_SCOPE( timerSubmit );
+        drawCurve( hermiteCurves.getVertices( i ), bezierCurves.getVertices( i ), bernsteinControlVertices[i], selectedCurve == i );
+	}
 
-        std::deque<vec3> bernsteinVertices;
-        if( isBernstein ){
-            //calculate bezier curve (bernstein)
-            bernsteinVertices = bernstein( bernsteinControlVertices[i], 10 );
-        }else{
-            // calculate bezier curve (casteljau)
-            bernsteinVertices = casteljau( bernsteinControlVertices[i], 10 );
+	// points equally spaced along the chain, only the tables of the edited curves are rebuilt
+	if( isArcLengthPoints ){
+        std::vector<vec3> points( amountArcLengthPoints );
+        {
+            PROFILE_SCOPE( timerArcLength );
+            sampleChainUniform( bernsteinControlVertices, arcLengths, amountArcLengthPoints, &points[0] );
+        }
+        PROFILE_SCOPE( timerSubmit );
+        PROFILE_COUNT( counterVerticesSubmitted, points.size() );
+        glPointSize( 3 );
+        glBegin(GL_POINTS);
+        glColor3f(1.,1.,0.);
+        for( int i = 0; i < points.size(); i++ ){
+            glVertex3f( points[i].getX(), points[i].getY(), points[i].getZ() );
         }
+        glEnd();
+	}
 
-        drawCurve( bernsteinVertices, bernsteinControlVertices[i], selectedCurve == i );
+	// Catmull-Rom spline through the joints, 10 samples per segment
+	if( isCatmullRom && bernsteinControlVertices.size() > 0 ){
+        std::vector<vec3> joints, points;
+        FOR(i,bernsteinControlVertices.size()){
+            joints.push_back( bernsteinControlVertices[i][0] );
+        }
+        curveView last = bernsteinControlVertices[bernsteinControlVertices.size()-1];
+        joints.push_back( last[last.size()-1] );
+        hermiteSpline catmullRom;
+        catmullRom.build( curveView( &joints[0], joints.size() ) );
+        catmullRom.sample( *pool, 10, points );
+        PROFILE_SCOPE( timerSubmit );
+        PROFILE_COUNT( counterVerticesSubmitted, points.size() );
+        glBegin(GL_LINE_STRIP);
+        glColor3f(0.,1.,1.);
+        for( int i = 0; i < points.size(); i++ ){
+            glVertex3f( points[i].getX(), points[i].getY(), points[i].getZ() );
+        }
+        glEnd();
 	}
+}
+
+void display(void)
+{
+	{
+        PROFILE_SCOPE( timerFrame );
+        drawScene();
+	}
+
+	// timers of the previous frame (this one is still open)
+	if( isProfileOverlay ){
+        drawProfile();
+	}
+	PROFILE_FRAME();
 
 	glFlush();
 }
@@ -266,40 +377,114 @@ void display(void)
 /* Au cas ou la fenetre est modifiee ou deplacee */
 void reshape(int w, int h)
 {
+   viewportWidth = w;
+   viewportHeight = h;
+   if( isAdaptive ){
+       // the tolerance in pixels changed in world units
+       bezierCurves.markAllDirty();
+   }
    glViewport(0, 0, (GLsizei) w, (GLsizei) h);
    glMatrixMode(GL_PROJECTION);
    glLoadIdentity();
-   glOrtho(-3, 11, -7, 7, -1, 1);
+   glOrtho(orthoLeft, orthoRight, orthoBottom, orthoTop, -1, 1);
    glMatrixMode(GL_MODELVIEW);
    glLoadIdentity();
 }
 
+// selects the curve, the selected control point is kept when the curve has it (curves of a file are not all cubic)
+void selectCurve( int curve ){
+    selectedCurve = curve;
+    int amountPoints = bernsteinControlVertices[curve].size();
+    if( selectedControlPoint >= amountPoints ){
+        selectedControlPoint = amountPoints-1;
+    }
+}
+
 void keyboard(unsigned char key, int x, int y)
 {
+   vec3 selectedBefore = bernsteinControlVertices[selectedCurve][selectedControlPoint];
    switch (key) {
        // Selecting Control Point
     case '0': case '1': case '2': case '3':
-        selectedControlPoint = key - '0';
+        if( key - '0' < bernsteinControlVertices[selectedCurve].size() ){
+            selectedControlPoint = key - '0';
+        }
         break;
         // Selecting Curve
     case '7': case '8': case '9':
         if( bernsteinControlVertices.size() > key - '7' ){
-            selectedCurve = key - '7';
+            selectCurve( key - '7' );
         }
         break;
 
     // Moving Control Point
     case 'd':    // move right
        bernsteinControlVertices[selectedCurve][selectedControlPoint].setX( bernsteinControlVertices[selectedCurve][selectedControlPoint].getX()+selectedControlPointMoveStep );
+       invalidateCurve( selectedCurve );
       break;
     case 'q':    // move left
        bernsteinControlVertices[selectedCurve][selectedControlPoint].setX( bernsteinControlVertices[selectedCurve][selectedControlPoint].getX()-selectedControlPointMoveStep );
+       invalidateCurve( selectedCurve );
       break;
     case 'z':    // move up
        bernsteinControlVertices[selectedCurve][selectedControlPoint].setY( bernsteinControlVertices[selectedCurve][selectedControlPoint].getY()+selectedControlPointMoveStep );
+       invalidateCurve( selectedCurve );
       break;
     case 's':    // move down
        bernsteinControlVertices[selectedCurve][selectedControlPoint].setY( bernsteinControlVertices[selectedCurve][selectedControlPoint].getY()-selectedControlPointMoveStep );
+       invalidateCurve( selectedCurve );
+      break;
+
+    // Switching the tessellation of cubic segments
+    case 'f':
+       isForwardDifferences = !isForwardDifferences;
+       invalidateAllCurves();
+      break;
+    case 'h':
+       isHorner = !isHorner;
+       invalidateAllCurves();
+      break;
+    case 'a':
+       isAdaptive = !isAdaptive;
+       invalidateAllCurves();
+      break;
+    case 'l':
+       isArcLengthPoints = !isArcLengthPoints;
+      break;
+    case 'k':
+       isCatmullRom = !isCatmullRom;
+      break;
+    case 'p':
+       isProfileOverlay = !isProfileOverlay;
+       if( !profiler::isEnabled() ){
+           printf( "built without CURVES_PROFILE, nothing is measured\n" );
+       }
+      break;
+    case 'c':
+       isC2 = !isC2;
+       if( isC2 && !chainSolver.solve( bernsteinControlVertices ) ){
+           printf( "the C2 spline needs cubic segments only\n" );
+           isC2 = false;
+       }
+       if( !isC2 ){
+           enforceC1( bernsteinControlVertices );
+       }
+       invalidateCurves( 0, bernsteinControlVertices.size()-1 );
+      break;
+    case 'j':
+       if( profiler::shared().dumpJson( "profile.json" ) ){
+           printf( "profile.json written (%lld frames)\n", profiler::shared().getFrames() );
+       }
+      break;
+
+    // Amount of threads calculating the curves
+    case '+': case '-':
+       tessellationThreads = pool->getAmountThreads() + (key == '+' ? 1 : -1);
+       if( tessellationThreads < 1 ){
+           tessellationThreads = 1;
+       }
+       delete pool;
+       pool = new tessellationPool( tessellationThreads );
       break;
 
    case ESC:
@@ -310,22 +495,42 @@ void keyboard(unsigned char key, int x, int y)
    }
 
     // adjust continuity
-    if( selectedCurve < bernsteinControlVertices.size()-1 && selectedControlPoint == bernsteinControlVertices[selectedCurve].size()-1 ){
-        adjustContinuity( &bernsteinControlVertices[selectedCurve][selectedControlPoint], &bernsteinControlVertices[selectedCurve+1][0] );
-        adjustContinuityTangent( &bernsteinControlVertices[selectedCurve][selectedControlPoint], &bernsteinControlVertices[selectedCurve][selectedControlPoint-1], &bernsteinControlVertices[selectedCurve+1][1] );
+    vec3 moved = bernsteinControlVertices[selectedCurve][selectedControlPoint] - selectedBefore;
+    if( moved != vec3() ){
+        int first, last;
+        if( isC2 ){
+            // the inner points follow from the joints: the nearest joint moves instead
+            int knot = selectedControlPoint <= 1 ? selectedCurve : selectedCurve+1;
+            chainSolver.moveKnot( bernsteinControlVertices, knot, chainSolver.getKnot( knot ) + moved, first, last );
+        }else{
+            enforceC1( bernsteinControlVertices, selectedCurve, selectedControlPoint, first, last );
+        }
+        invalidateCurves( first, last );
     }
-    else if( selectedCurve > 0 && selectedControlPoint == 0 ){
-        adjustContinuity( &bernsteinControlVertices[selectedCurve][selectedControlPoint], &bernsteinControlVertices[selectedCurve-1][bernsteinControlVertices[selectedCurve-1].size()-1] );
-        adjustContinuityTangent( &bernsteinControlVertices[selectedCurve][selectedControlPoint], &bernsteinControlVertices[selectedCurve][selectedControlPoint+1], &bernsteinControlVertices[selectedCurve-1][bernsteinControlVertices[selectedCurve-1].size()-2] );
+
+   glutPostRedisplay();
+}
+
+// selects the control point under the cursor, or else the curve under it
+void mouse(int button, int state, int x, int y)
+{
+    if( button != GLUT_LEFT_BUTTON || state != GLUT_DOWN ){
+        return;
     }
-    else if( selectedCurve < bernsteinControlVertices.size()-1 && selectedControlPoint == bernsteinControlVertices[selectedCurve].size()-2 ){
-        adjustContinuityTangent( &bernsteinControlVertices[selectedCurve][selectedControlPoint+1], &bernsteinControlVertices[selectedCurve][selectedControlPoint], &bernsteinControlVertices[selectedCurve+1][1] );
+    // window to world, through the glOrtho of reshape() (y goes down in the window)
+    vec3 cursor( orthoLeft + (orthoRight-orthoLeft)*x/(double)viewportWidth, orthoTop - (orthoTop-orthoBottom)*y/(double)viewportHeight, 0 );
+    curveHit hit = curveIndex.pickControlPoint( cursor, selectedControlPointSquareSize );
+    if( hit.isFound() ){
+        selectedCurve = hit.curve;
+        selectedControlPoint = hit.controlPoint;
     }
-    else if( selectedCurve > 0 && selectedControlPoint == 1 ){
-        adjustContinuityTangent( &bernsteinControlVertices[selectedCurve][selectedControlPoint-1], &bernsteinControlVertices[selectedCurve][selectedControlPoint], &bernsteinControlVertices[selectedCurve-1][bernsteinControlVertices[selectedCurve-1].size()-2] );
+    else{
+        hit = curveIndex.pickCurve( cursor, pixelsToWorld( 5, orthoLeft, orthoRight, orthoBottom, orthoTop, viewportWidth, viewportHeight ) );
+        if( hit.isFound() ){
+            selectCurve( hit.curve );
+        }
     }
-
-   glutPostRedisplay();
+    glutPostRedisplay();
 }
 
 int main(int argc, char **argv)
@@ -334,9 +539,13 @@ int main(int argc, char **argv)
    glutInit(&argc, argv);
    glutInitDisplayMode(GLUT_SINGLE | GLUT_RGB);
    glutCreateWindow("Courbe de Bzier");
+   if( argc > 1 ){
+      scenePath = argv[1];
+   }
    init();
    glutReshapeFunc(reshape);
    glutKeyboardFunc(keyboard);
+   glutMouseFunc(mouse);
    glutDisplayFunc(display);
    glutMainLoop();
    return 0;
@@ -6,10 +6,15 @@
  *   q :  gauche
  *   z : en haut
  *   s : en bas
+ *   + / - : augmente/diminue le niveau de subdivision
+ *   c : change de schma (Chaikin, B-spline cubique de Lane-Riesenfeld, 4 points)
+ * Au-del de maxStoredLevels, Chaikin est envoy point par point et les deux autres schmas restent  maxStoredLevels.
  *
  */
 
+ #ifdef _WIN32
  #include <windows.h>
+ #endif
 
 #include <GL/glut.h>
 #include <GL/glu.h>
@@ -20,6 +25,9 @@
 #include "struct.h"
 #include "vec3.h"
 #include "utils.h"
+#include "subdivision.h"
+#include "subdivisionSchemes.h"
+#include "splineStore.h"
 
 /* au cas ou M_PI ne soit defini */
 #ifndef M_PI
@@ -39,25 +47,13 @@ vec3 p2( 3,3,0 );
 vec3 p3( 1,0,0 );
 vec3 p4( 3,-3,0 );
 vec3 p5( 0,-3,0 );
-std::deque< std::deque<vec3> > generalControlVertices;
-
-vec3 chaikinPoint( vec3 p1, vec3 p2 ){
-    return p1.multiplication( 3/4. ).addition( p2.multiplication( 1/4. ) );
-}
-
-std::deque<vec3> chaikin( std::deque<vec3> controlPoints, int level, int maxLevel ){
-    if( level == maxLevel ){
-        return controlPoints;
-    }
-    else{
-        std::deque<vec3> result;
-        for( int i=0; i<controlPoints.size(); i++ ){
-            result.push_back( chaikinPoint( controlPoints[i], controlPoints[(i+1)%controlPoints.size()] ) );
-            result.push_back( chaikinPoint( controlPoints[(i+1)%controlPoints.size()], controlPoints[i] ) );
-        }
-        return chaikin( result, level+1, maxLevel );
-    }
-}
+splineStore generalControlVertices;    // control points of every curve in one array, read through curveViews
+int subdivisionLevels = 5;
+int maxStoredLevels = 8;       // deeper Chaikin levels are streamed to OpenGL instead of being stored
+std::deque<chaikinIncremental> subdividedCurves;      // every level of each curve, updated locally by keyboard()
+int subdivisionScheme = 0;     // 0 Chaikin, 1 cubic B-spline (Lane-Riesenfeld), 2 4-point interpolating (key c)
+subdivisionEngine< laneRiesenfeldStencil<3> > cubicEngine;
+subdivisionEngine<fourPointStencil> fourPointEngine;
 
 /* initialisation d'OpenGL*/
 static void init(void)
@@ -75,10 +71,21 @@ static void init(void)
     controlPoints.push_back(p5);
     //controlPoints.push_back(p0);
 
-    generalControlVertices.push_back( controlPoints );
+    generalControlVertices.addCurve( controlPoints );
+}
+
+// Print the curve generated point by point (deep Chaikin levels)
+void drawStream( chaikinStream & stream ){
+	glBegin(GL_LINE_STRIP);
+	glColor3f(0.,1.,0.);
+	vec3 vertex;
+	while( stream.next( vertex ) ){
+        glVertex3f( vertex.getX(), vertex.getY(), vertex.getZ() );
+	}
+	glEnd();
 }
 
-void drawCurve(std::deque<vec3> vertices, std::deque<vec3> controlPoints, bool isSelected){
+void drawCurve(std::vector<vec3> & vertices, curveView controlPoints, bool isSelected){
 	// Print Control Box
 	glBegin(GL_LINE_LOOP);
 	//glBegin(GL_POLYGON);
@@ -116,10 +123,30 @@ void display(void)
 	glMatrixMode(GL_MODELVIEW);
 	glLoadIdentity();
 
+	subdividedCurves.resize( generalControlVertices.size() );
 	FOR(i,generalControlVertices.size()){
-        std::deque<vec3> curveVertices = chaikin( generalControlVertices[i], 0, 5 );
+        if( subdivisionScheme == 0 && subdivisionLevels > maxStoredLevels ){
+            std::vector<vec3> noVertices;
+            drawCurve( noVertices, generalControlVertices[i], selectedCurve == i );
+            chaikinStream stream( generalControlVertices[i], subdivisionLevels );
+            drawStream( stream );
+            continue;
+        }
 
-        drawCurve( curveVertices, generalControlVertices[i], selectedCurve == i );
+        // the other schemes have no streamed path: they stop at maxStoredLevels, higher order schemes
+        // reach the same smoothness with fewer levels
+        int storedLevels = subdivisionLevels < maxStoredLevels ? subdivisionLevels : maxStoredLevels;
+        if( subdivisionScheme == 1 ){
+            drawCurve( cubicEngine.subdivide( generalControlVertices[i], true, storedLevels-1 ), generalControlVertices[i], selectedCurve == i );
+        }else if( subdivisionScheme == 2 ){
+            drawCurve( fourPointEngine.subdivide( generalControlVertices[i], true, storedLevels-1 ), generalControlVertices[i], selectedCurve == i );
+        }else{
+            // full subdivision only for new curves, the edits are applied by keyboard()
+            if( subdividedCurves[i].getAmountPoints() != generalControlVertices[i].size() || subdividedCurves[i].getAmountLevels() != subdivisionLevels ){
+                subdividedCurves[i].build( generalControlVertices[i], subdivisionLevels );
+            }
+            drawCurve( subdividedCurves[i].getResult(), generalControlVertices[i], selectedCurve == i );
+        }
 	}
 
 	glFlush();
@@ -164,6 +191,23 @@ void keyboard(unsigned char key, int x, int y)
        generalControlVertices[selectedCurve][selectedControlPoint].setY( generalControlVertices[selectedCurve][selectedControlPoint].getY()-selectedControlPointMoveStep );
       break;
 
+    // Changing the subdivision level
+    case '+':
+       if( subdivisionLevels < 20 ){
+           subdivisionLevels++;
+       }
+      break;
+    case '-':
+       if( subdivisionLevels > 1 ){
+           subdivisionLevels--;
+       }
+      break;
+
+    // Switching the subdivision scheme
+    case 'c':
+       subdivisionScheme = (subdivisionScheme+1) % 3;
+      break;
+
    case ESC:
       exit(0);
       break;
@@ -171,6 +215,11 @@ void keyboard(unsigned char key, int x, int y)
        break;
    }
 
+    // re-subdivide only the window influenced by the moved point
+    if( (key == 'd' || key == 'q' || key == 'z' || key == 's') && selectedCurve < subdividedCurves.size() && subdividedCurves[selectedCurve].isBuilt() ){
+        subdividedCurves[selectedCurve].update( selectedControlPoint, generalControlVertices[selectedCurve][selectedControlPoint] );
+    }
+
    glutPostRedisplay();
 }
 
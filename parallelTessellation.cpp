@@ -0,0 +1,195 @@
+#include "parallelTessellation.h"
+#include "bernsteinBasis.h"
+#include "bezierFixed.h"
+#include "casteljau.h"
+
+tessellationPool::tessellationPool( int amountThreads ) : next( 0 ) {
+	if( amountThreads <= 0 ){
+		amountThreads = std::thread::hardware_concurrency();
+	}
+	for( int i = 1; i < amountThreads; i++ ){
+		this->workers.push_back( std::thread( &tessellationPool::workerLoop, this ) );
+	}
+}
+
+tessellationPool::~tessellationPool() {
+	{
+		std::lock_guard<std::mutex> lock( this->mutex );
+		this->stopping = true;
+	}
+	this->wake.notify_all();
+	for( int i = 0; i < this->workers.size(); i++ ){
+		this->workers[i].join();
+	}
+}
+
+int tessellationPool::getAmountThreads() const {
+	return this->workers.size()+1;
+}
+
+void tessellationPool::runChunks() {
+	while( true ){
+		int begin = this->next.fetch_add( this->chunk );
+		if( begin >= this->count ){
+			return;
+		}
+		int end = begin + this->chunk < this->count ? begin + this->chunk : this->count;
+		(*this->body)( begin, end );
+	}
+}
+
+void tessellationPool::workerLoop() {
+	long long seen = 0;
+	while( true ){
+		{
+			std::unique_lock<std::mutex> lock( this->mutex );
+			this->wake.wait( lock, [&](){ return this->stopping || this->generation != seen; } );
+			if( this->stopping ){
+				return;
+			}
+			seen = this->generation;
+		}
+		this->runChunks();
+		{
+			std::lock_guard<std::mutex> lock( this->mutex );
+			this->active--;
+			if( this->active == 0 ){
+				this->done.notify_one();
+			}
+		}
+	}
+}
+
+void tessellationPool::parallelFor( int count, int chunk, const std::function<void(int,int)> & body ) {
+	if( chunk < 1 ){
+		chunk = 1;
+	}
+	if( this->workers.empty() || count <= chunk ){
+		body( 0, count );
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock( this->mutex );
+		this->body = &body;
+		this->count = count;
+		this->chunk = chunk;
+		this->next = 0;
+		this->active = this->workers.size();
+		this->generation++;
+	}
+	this->wake.notify_all();
+	// the calling thread works too
+	this->runChunks();
+
+	std::unique_lock<std::mutex> lock( this->mutex );
+	this->done.wait( lock, [&](){ return this->active == 0; } );
+	this->body = NULL;
+}
+
+template<typename T>
+static void tessellateChainT( tessellationPool & pool, int amountCurves, int verticesPerCurve,
+                              const std::function<void(int, vector3<T> *)> & tessellate,
+                              std::vector< vector3<T> > & vertices, std::vector<int> & offsets ){
+	offsets.resize( amountCurves+1 );
+	for( int i = 0; i <= amountCurves; i++ ){
+		offsets[i] = i*verticesPerCurve;
+	}
+	vertices.resize( offsets[amountCurves] );
+
+	// chunks of a few curves, small enough to balance the threads
+	int chunk = amountCurves/(8*pool.getAmountThreads()) + 1;
+	pool.parallelFor( amountCurves, chunk, [&]( int begin, int end ){
+		for( int i = begin; i < end; i++ ){
+			tessellate( i, &vertices[offsets[i]] );
+		}
+	} );
+}
+
+void tessellateChain( tessellationPool & pool, int amountCurves, int verticesPerCurve,
+                      const std::function<void(int, vec3 *)> & tessellate,
+                      std::vector<vec3> & vertices, std::vector<int> & offsets ){
+	tessellateChainT( pool, amountCurves, verticesPerCurve, tessellate, vertices, offsets );
+}
+
+void tessellateChain( tessellationPool & pool, int amountCurves, int verticesPerCurve,
+                      const std::function<void(int, vec3f *)> & tessellate,
+                      std::vector<vec3f> & vertices, std::vector<int> & offsets ){
+	tessellateChainT( pool, amountCurves, verticesPerCurve, tessellate, vertices, offsets );
+}
+
+// basis tables of the degrees above maxFixedDegree found in the curves, indexed by degree: obtained once
+// before the parallel loop instead of once per curve (bernsteinBasisCache::get takes a lock)
+template<typename Curves>
+static std::vector< std::shared_ptr<const bernsteinBasis> > genericBases( Curves & curves, int amountSamples ){
+	std::vector< std::shared_ptr<const bernsteinBasis> > bases;
+	for( int i = 0; i < curves.size(); i++ ){
+		int degree = curves[i].size()-1;
+		if( degree <= maxFixedDegree ){
+			continue;
+		}
+		if( degree >= (int)bases.size() ){
+			bases.resize( degree+1 );
+		}
+		if( !bases[degree] ){
+			bases[degree] = bernsteinBasisCache::shared().get( degree, amountSamples );
+		}
+	}
+	return bases;
+}
+
+// curves[i] is a deque or a curveView (splineStore, curveFileReader), of double control points.
+// T is the precision of the vertices, the samples are computed in double
+template<typename Curves, typename T>
+static void tessellateBezierCurves( tessellationPool & pool, Curves & curves, int amountSamples, bool isBernstein,
+                                    std::vector< vector3<T> > & vertices, std::vector<int> & offsets ){
+	int amount = amountSamples+2;   // at least 2 samples will be created
+	if( isBernstein ){
+		std::vector< std::shared_ptr<const bernsteinBasis> > bases = genericBases( curves, amountSamples );
+		tessellateChain( pool, curves.size(), amount, [&]( int i, vector3<T> * out ){
+			int degree = curves[i].size()-1;
+			if( degree > maxFixedDegree ){
+				bases[degree]->evaluate( curves[i], out );
+			}else{
+				bernsteinDispatch( curves[i], amountSamples, out );
+			}
+		}, vertices, offsets );
+	}
+	else{
+		tessellateChain( pool, curves.size(), amount, [&]( int i, vector3<T> * out ){
+			casteljauEvaluator evaluator( curves[i].size()-1 );
+			for( int s = 0; s < amount; s++ ){
+				out[s] = vector3<T>( evaluator.evaluate( s/((double)amount-1), curves[i] ) );
+			}
+		}, vertices, offsets );
+	}
+}
+
+void tessellateBezierChain( tessellationPool & pool, std::deque< std::deque<vec3> > & curves, int amountSamples, bool isBernstein,
+                            std::vector<vec3> & vertices, std::vector<int> & offsets ){
+	tessellateBezierCurves( pool, curves, amountSamples, isBernstein, vertices, offsets );
+}
+
+void tessellateBezierChain( tessellationPool & pool, splineStore & curves, int amountSamples, bool isBernstein,
+                            std::vector<vec3> & vertices, std::vector<int> & offsets ){
+	tessellateBezierCurves( pool, curves, amountSamples, isBernstein, vertices, offsets );
+}
+
+void tessellateBezierChain( tessellationPool & pool, const curveFileReader & curves, int amountSamples, bool isBernstein,
+                            std::vector<vec3> & vertices, std::vector<int> & offsets ){
+	tessellateBezierCurves( pool, curves, amountSamples, isBernstein, vertices, offsets );
+}
+
+void tessellateBezierChain( tessellationPool & pool, std::deque< std::deque<vec3> > & curves, int amountSamples, bool isBernstein,
+                            std::vector<vec3f> & vertices, std::vector<int> & offsets ){
+	tessellateBezierCurves( pool, curves, amountSamples, isBernstein, vertices, offsets );
+}
+
+void tessellateBezierChain( tessellationPool & pool, splineStore & curves, int amountSamples, bool isBernstein,
+                            std::vector<vec3f> & vertices, std::vector<int> & offsets ){
+	tessellateBezierCurves( pool, curves, amountSamples, isBernstein, vertices, offsets );
+}
+
+void tessellateBezierChain( tessellationPool & pool, const curveFileReader & curves, int amountSamples, bool isBernstein,
+                            std::vector<vec3f> & vertices, std::vector<int> & offsets ){
+	tessellateBezierCurves( pool, curves, amountSamples, isBernstein, vertices, offsets );
+}
@@ -0,0 +1,67 @@
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include "vec3.h"
+#include "splineStore.h"
+#include "curveFile.h"
+
+#pragma once
+
+// Persistent worker threads running parallel-for loops; idle workers grab the next chunk of indices
+class tessellationPool
+{
+private:
+	std::vector<std::thread> workers;
+	std::mutex mutex;
+	std::condition_variable wake, done;
+	const std::function<void(int,int)> * body = NULL;
+	int count = 0, chunk = 1;
+	std::atomic<int> next;
+	int active = 0;
+	long long generation = 0;
+	bool stopping = false;
+
+	void workerLoop();
+	void runChunks();
+
+public:
+	// amountThreads counts the calling thread, 0 uses one thread per core
+	tessellationPool( int amountThreads = 0 );
+	~tessellationPool();
+
+	int getAmountThreads() const;
+
+	// calls body( begin, end ) on disjoint chunks covering [0,count), returns when every chunk is done
+	void parallelFor( int count, int chunk, const std::function<void(int,int)> & body );
+};
+
+// tessellate amountCurves curves of verticesPerCurve vertices each into one preallocated array.
+// offsets[i] is the first vertex of curve i (offsets[amountCurves] the total), tessellate( i, out ) writes curve i.
+// Each curve only touches its own range: the result does not depend on the amount of threads.
+void tessellateChain( tessellationPool & pool, int amountCurves, int verticesPerCurve,
+                      const std::function<void(int, vec3 *)> & tessellate,
+                      std::vector<vec3> & vertices, std::vector<int> & offsets );
+// same into a float buffer (half the bytes per vertex)
+void tessellateChain( tessellationPool & pool, int amountCurves, int verticesPerCurve,
+                      const std::function<void(int, vec3f *)> & tessellate,
+                      std::vector<vec3f> & vertices, std::vector<int> & offsets );
+
+// tessellateChain over Bezier curves, with bernsteinDispatch or de Casteljau (same samples as bernstein()/casteljau())
+void tessellateBezierChain( tessellationPool & pool, std::deque< std::deque<vec3> > & curves, int amountSamples, bool isBernstein,
+                            std::vector<vec3> & vertices, std::vector<int> & offsets );
+void tessellateBezierChain( tessellationPool & pool, splineStore & curves, int amountSamples, bool isBernstein,
+                            std::vector<vec3> & vertices, std::vector<int> & offsets );
+// straight from a mapped curve file, without copying the control points
+void tessellateBezierChain( tessellationPool & pool, const curveFileReader & curves, int amountSamples, bool isBernstein,
+                            std::vector<vec3> & vertices, std::vector<int> & offsets );
+// float vertices of the double control points: each sample is computed in double and stored in float
+void tessellateBezierChain( tessellationPool & pool, std::deque< std::deque<vec3> > & curves, int amountSamples, bool isBernstein,
+                            std::vector<vec3f> & vertices, std::vector<int> & offsets );
+void tessellateBezierChain( tessellationPool & pool, splineStore & curves, int amountSamples, bool isBernstein,
+                            std::vector<vec3f> & vertices, std::vector<int> & offsets );
+void tessellateBezierChain( tessellationPool & pool, const curveFileReader & curves, int amountSamples, bool isBernstein,
+                            std::vector<vec3f> & vertices, std::vector<int> & offsets );
@@ -0,0 +1,153 @@
+#include "powerBasis.h"
+#include "profiler.h"
+#include <float.h>
+#include "math.h"
+
+int powerBasisSegment::maxDegree = 20;
+double powerBasisSegment::maxRelativeError = 1e-10;
+
+powerBasisSegment::powerBasisSegment() {
+}
+
+powerBasisSegment::powerBasisSegment( const std::deque<vec3> & controlPoints ) {
+	this->set( controlPoints );
+}
+
+void powerBasisSegment::set( const std::deque<vec3> & controlPoints ) {
+	this->controlPoints = controlPoints;
+	this->convert();
+}
+
+void powerBasisSegment::set( const curveView & controlPoints ) {
+	this->controlPoints.assign( controlPoints.begin(), controlPoints.end() );
+	this->convert();
+}
+
+// coefficients of the power basis from the stored control points
+void powerBasisSegment::convert() {
+	this->degree = this->controlPoints.size()-1;
+	int n = this->degree;
+	this->fallback.reserve( n );
+	this->coefficients.assign( 3*(n+1), 0 );
+
+	// forward differences of the control points: cj = C(n,j) * delta^j P0
+	std::vector<double> differences( 3*(n+1) );
+	double maxPoint = 0;
+	for( int i = 0; i <= n; i++ ){
+		differences[3*i] = this->controlPoints[i].getX();
+		differences[3*i+1] = this->controlPoints[i].getY();
+		differences[3*i+2] = this->controlPoints[i].getZ();
+		for( int c = 0; c < 3; c++ ){
+			maxPoint = fmax( maxPoint, fabs( differences[3*i+c] ) );
+		}
+	}
+	double binomial = 1;	// C(n,j), built along j with the recurrence C(n,j+1) = C(n,j)*(n-j)/(j+1)
+	double sum = 0;
+	for( int j = 0; j <= n; j++ ){
+		for( int c = 0; c < 3; c++ ){
+			this->coefficients[3*j+c] = binomial * differences[c];
+			sum += fabs( this->coefficients[3*j+c] );
+		}
+		// next order of differences
+		for( int i = 0; i < n-j; i++ ){
+			for( int c = 0; c < 3; c++ ){
+				differences[3*i+c] = differences[3*(i+1)+c] - differences[3*i+c];
+			}
+		}
+		binomial = binomial*(n-j)/(j+1);
+	}
+
+	this->conditionNumber = maxPoint > 0 ? sum/maxPoint : 1;
+	this->isConditioned = n <= maxDegree && this->conditionNumber*(n+1)*DBL_EPSILON <= maxRelativeError;
+}
+
+int powerBasisSegment::getDegree() const {
+	return this->degree;
+}
+bool powerBasisSegment::usesPowerBasis() const {
+	return this->isConditioned;
+}
+double powerBasisSegment::getConditionNumber() const {
+	return this->conditionNumber;
+}
+
+vec3 powerBasisSegment::evaluate( double u ) {
+	if( !this->isConditioned ){
+		return this->fallback.evaluate( u, this->controlPoints );
+	}
+	const double * c = &this->coefficients[0];
+	int n = this->degree;
+	double x = c[3*n], y = c[3*n+1], z = c[3*n+2];
+	for( int j = n-1; j >= 0; j-- ){
+		x = x*u + c[3*j];
+		y = y*u + c[3*j+1];
+		z = z*u + c[3*j+2];
+	}
+	return vec3( x, y, z );
+}
+
+void powerBasisSegment::tessellate( int amountSamples, vec3 * result ) {
+	int amount = amountSamples+2;   // at least 2 samples will be created
+	for( int i = 0; i < amount; i++ ){
+		result[i] = this->evaluate( i/((double)amount-1) );
+	}
+}
+
+std::deque<vec3> powerBasisSegment::tessellate( int amountSamples ) {
+	std::vector<vec3> samples( amountSamples+2 );
+	this->tessellate( amountSamples, &samples[0] );
+	return std::deque<vec3>( samples.begin(), samples.end() );
+}
+
+powerBasisCache::powerBasisCache() : hits( 0 ), misses( 0 ) {
+}
+
+void powerBasisCache::resize( int amountCurves ) {
+	this->segments.resize( amountCurves );
+	this->valid.resize( amountCurves, false );
+}
+
+void powerBasisCache::invalidate( int curve ) {
+	if( curve >= 0 && curve < this->valid.size() ){
+		this->valid[curve] = false;
+	}
+}
+
+void powerBasisCache::invalidateAll() {
+	for( int i = 0; i < this->valid.size(); i++ ){
+		this->valid[i] = false;
+	}
+}
+
+template<typename Points>
+powerBasisSegment & powerBasisCache::getPoints( int curve, const Points & controlPoints ) {
+	if( curve >= this->segments.size() ){
+		this->resize( curve+1 );
+	}
+	if( this->valid[curve] ){
+		this->hits++;
+		PROFILE_COUNT( counterPowerBasisHits, 1 );
+	}
+	else{
+		this->misses++;
+		PROFILE_COUNT( counterPowerBasisMisses, 1 );
+		this->segments[curve].set( controlPoints );
+		this->valid[curve] = true;
+	}
+	return this->segments[curve];
+}
+
+powerBasisSegment & powerBasisCache::get( int curve, const std::deque<vec3> & controlPoints ) {
+	return this->getPoints( curve, controlPoints );
+}
+
+powerBasisSegment & powerBasisCache::get( int curve, const curveView & controlPoints ) {
+	return this->getPoints( curve, controlPoints );
+}
+
+long long powerBasisCache::getHits() const {
+	return this->hits;
+}
+long long powerBasisCache::getMisses() const {
+	return this->misses;
+}
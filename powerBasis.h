@@ -0,0 +1,76 @@
+#include <deque>
+#include <vector>
+#include <atomic>
+#include "vec3.h"
+#include "casteljau.h"
+#include "curveView.h"
+
+#pragma once
+
+/**
+ *	Bezier segment converted to the power basis p(u) = c0 + c1*u + ... + cn*u^n,
+ * evaluated with Horner's rule (n multiply-adds per coordinate, no binomial, no pow).
+ * The monomial form is ill-conditioned for high degrees: when the degree exceeds maxDegree
+ * or the estimated relative error exceeds maxRelativeError, the segment falls back to de Casteljau.
+ *
+ */
+class powerBasisSegment
+{
+private:
+	int degree = -1;
+	bool isConditioned = false;
+	double conditionNumber = 0;		// sum |cj| / max |Pi|
+	std::vector<double> coefficients;	// (degree+1) x 3, coefficient of u^j for x, y and z
+	std::deque<vec3> controlPoints;		// kept for the de Casteljau fallback
+	casteljauEvaluator fallback;
+
+	void convert();
+
+public:
+	static int maxDegree;
+	static double maxRelativeError;
+
+	powerBasisSegment();
+	powerBasisSegment( const std::deque<vec3> & controlPoints );
+
+	void set( const std::deque<vec3> & controlPoints );
+	void set( const curveView & controlPoints );
+
+	int getDegree() const;
+	bool usesPowerBasis() const;
+	double getConditionNumber() const;
+
+	// position on the curve related to the factor u [0,1]
+	vec3 evaluate( double u );
+	// amountSamples+2 uniform samples in [0,1], as bernstein()
+	void tessellate( int amountSamples, vec3 * result );
+	std::deque<vec3> tessellate( int amountSamples );
+};
+
+// Power basis segments of a list of curves, rebuilt only after invalidate().
+// get() is safe from several threads for distinct curves once resize() covers them
+class powerBasisCache
+{
+private:
+	std::deque<powerBasisSegment> segments;
+	std::deque<bool> valid;
+	std::atomic<long long> hits, misses;	// get() may run for different curves on several threads
+
+	template<typename Points>
+	powerBasisSegment & getPoints( int curve, const Points & controlPoints );
+
+public:
+	powerBasisCache();
+
+	void resize( int amountCurves );
+	// to be called when a control point of the curve moves
+	void invalidate( int curve );
+	void invalidateAll();
+
+	// obtains the segment of the curve, converting the control points if it was invalidated
+	powerBasisSegment & get( int curve, const std::deque<vec3> & controlPoints );
+	powerBasisSegment & get( int curve, const curveView & controlPoints );
+
+	long long getHits() const;
+	long long getMisses() const;
+};
@@ -0,0 +1,143 @@
+#include "profiler.h"
+
+static const char * timerNames[amountTimers] = {
+	"frame", "updateBezier", "updateHermite", "bernstein", "casteljau", "hermite",
+	"powerBasis", "forwardDifferences", "adaptive", "arcLength", "submit"
+};
+static const char * counterNames[amountCounters] = {
+	"samples", "allocations", "basisHits", "basisMisses", "powerBasisHits",
+	"powerBasisMisses", "arcLengthHits", "arcLengthMisses", "curvesTessellated", "verticesSubmitted"
+};
+
+// bucket of the histograms: floor(log2(nanoseconds)), 0 for 0 and 1 ns
+static int bucketOf( long long nanoseconds ){
+	int bucket = 0;
+	while( nanoseconds > 1 && bucket < profiler::amountBuckets-1 ){
+		nanoseconds >>= 1;
+		bucket++;
+	}
+	return bucket;
+}
+
+profiler::profiler() {
+	this->reset();
+}
+
+bool profiler::isEnabled() {
+#ifdef CURVES_PROFILE
+	return true;
+#else
+	return false;
+#endif
+}
+
+const char * profiler::getName( profileTimer timer ) {
+	return timerNames[timer];
+}
+const char * profiler::getName( profileCounter counter ) {
+	return counterNames[counter];
+}
+
+void profiler::endFrame() {
+	for( int t = 0; t < amountTimers; t++ ){
+		long long time = this->frameTimes[t].exchange( 0, std::memory_order_relaxed );
+		this->lastTimes[t] = time;
+		this->totalTimes[t] += time;
+		this->maxTimes[t] = time > this->maxTimes[t] ? time : this->maxTimes[t];
+		this->histograms[t][bucketOf( time )]++;
+	}
+	for( int c = 0; c < amountCounters; c++ ){
+		long long amount = this->frameCounts[c].exchange( 0, std::memory_order_relaxed );
+		this->lastCounts[c] = amount;
+		this->totalCounts[c] += amount;
+	}
+	this->frames++;
+}
+
+void profiler::reset() {
+	for( int t = 0; t < amountTimers; t++ ){
+		this->frameTimes[t] = 0;
+		this->lastTimes[t] = this->totalTimes[t] = this->maxTimes[t] = 0;
+		for( int b = 0; b < amountBuckets; b++ ){
+			this->histograms[t][b] = 0;
+		}
+	}
+	for( int c = 0; c < amountCounters; c++ ){
+		this->frameCounts[c] = 0;
+		this->lastCounts[c] = this->totalCounts[c] = 0;
+	}
+	this->frames = 0;
+}
+
+long long profiler::getFrames() const {
+	return this->frames;
+}
+long long profiler::getLastTime( profileTimer timer ) const {
+	return this->lastTimes[timer];
+}
+long long profiler::getLastCount( profileCounter counter ) const {
+	return this->lastCounts[counter];
+}
+long long profiler::getTotalTime( profileTimer timer ) const {
+	return this->totalTimes[timer];
+}
+long long profiler::getTotalCount( profileCounter counter ) const {
+	return this->totalCounts[counter];
+}
+long long profiler::getMaxTime( profileTimer timer ) const {
+	return this->maxTimes[timer];
+}
+long long profiler::getHistogram( profileTimer timer, int bucket ) const {
+	return this->histograms[timer][bucket];
+}
+
+std::string profiler::summary() const {
+	std::string result;
+	char line[128];
+	double frames = this->frames > 0 ? this->frames : 1;
+	for( int t = 0; t < amountTimers; t++ ){
+		snprintf( line, sizeof(line), "%-20s %9.3f ms  mean %9.3f ms\n", timerNames[t], this->lastTimes[t]*1e-6, this->totalTimes[t]*1e-6/frames );
+		result += line;
+	}
+	for( int c = 0; c < amountCounters; c++ ){
+		snprintf( line, sizeof(line), "%-20s %9lld     mean %9.1f\n", counterNames[c], this->lastCounts[c], this->totalCounts[c]/frames );
+		result += line;
+	}
+	return result;
+}
+
+void profiler::dumpJson( FILE * file ) const {
+	fprintf( file, "{\n  \"enabled\": %s,\n  \"frames\": %lld,\n  \"timers\": {\n", isEnabled() ? "true" : "false", this->frames );
+	for( int t = 0; t < amountTimers; t++ ){
+		// histogram without the empty buckets at the end
+		int used = amountBuckets;
+		while( used > 0 && this->histograms[t][used-1] == 0 ){
+			used--;
+		}
+		fprintf( file, "    \"%s\": { \"lastNs\": %lld, \"totalNs\": %lld, \"maxNs\": %lld, \"histogramLog2Ns\": [",
+		         timerNames[t], this->lastTimes[t], this->totalTimes[t], this->maxTimes[t] );
+		for( int b = 0; b < used; b++ ){
+			fprintf( file, b == 0 ? "%lld" : ", %lld", this->histograms[t][b] );
+		}
+		fprintf( file, "] }%s\n", t+1 < amountTimers ? "," : "" );
+	}
+	fprintf( file, "  },\n  \"counters\": {\n" );
+	for( int c = 0; c < amountCounters; c++ ){
+		fprintf( file, "    \"%s\": { \"last\": %lld, \"total\": %lld }%s\n", counterNames[c], this->lastCounts[c], this->totalCounts[c], c+1 < amountCounters ? "," : "" );
+	}
+	fprintf( file, "  }\n}\n" );
+}
+
+bool profiler::dumpJson( const char * path ) const {
+	FILE * file = fopen( path, "w" );
+	if( file == NULL ){
+		return false;
+	}
+	this->dumpJson( file );
+	return fclose( file ) == 0;
+}
+
+profiler & profiler::shared() {
+	static profiler instance;
+	return instance;
+}
@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+
+#pragma once
+
+// Sections of the hot paths timed by PROFILE_SCOPE
+enum profileTimer
+{
+	timerFrame,		// display() of main.Curves
+	timerUpdateBezier,	// tessellationCache::update of the Bezier curves (every thread)
+	timerUpdateHermite,
+	timerBernstein,		// evaluation of the samples, per algorithm
+	timerCasteljau,
+	timerHermite,
+	timerPowerBasis,
+	timerForwardDifferences,
+	timerAdaptive,
+	timerArcLength,
+	timerSubmit,		// glBegin/glVertex3f/glEnd
+	amountTimers
+};
+
+// Events counted by PROFILE_COUNT
+enum profileCounter
+{
+	counterSamples,			// points evaluated on the curves
+	counterAllocations,		// result containers and tables allocated by the kernels
+	counterBasisHits,		// bernsteinBasisCache
+	counterBasisMisses,
+	counterPowerBasisHits,		// powerBasisCache
+	counterPowerBasisMisses,
+	counterArcLengthHits,		// arcLengthCache
+	counterArcLengthMisses,
+	counterCurvesTessellated,	// curves recomputed by tessellationCache::update
+	counterVerticesSubmitted,	// glVertex3f calls
+	amountCounters
+};
+
+/**
+ *	Per-frame timers and counters of the hot paths, shared by every thread.
+ * The kernels add to the current frame with relaxed atomic additions (the time of a timer is summed over
+ * the threads), endFrame() closes the frame: it keeps its values, adds them to the totals and to a
+ * histogram per timer (frames by power of two of nanoseconds).
+ * The kernels only reach it through the PROFILE_ macros, which are empty unless CURVES_PROFILE is
+ * defined (cmake -DCURVES_PROFILE=ON): the instrumentation costs nothing in a normal build.
+ *
+ */
+class profiler
+{
+public:
+	static const int amountBuckets = 32;	// bucket b counts the frames of [2^b, 2^(b+1)) ns, the last one is open
+
+private:
+	std::atomic<long long> frameTimes[amountTimers];	// nanoseconds of the current frame
+	std::atomic<long long> frameCounts[amountCounters];
+	long long lastTimes[amountTimers], lastCounts[amountCounters];
+	long long totalTimes[amountTimers], totalCounts[amountCounters];
+	long long maxTimes[amountTimers];
+	long long histograms[amountTimers][amountBuckets];
+	long long frames;
+
+public:
+	profiler();
+
+	// true when the PROFILE_ macros are compiled in
+	static bool isEnabled();
+	static const char * getName( profileTimer timer );
+	static const char * getName( profileCounter counter );
+
+	void addTime( profileTimer timer, long long nanoseconds ){ this->frameTimes[timer].fetch_add( nanoseconds, std::memory_order_relaxed ); }
+	void count( profileCounter counter, long long amount = 1 ){ this->frameCounts[counter].fetch_add( amount, std::memory_order_relaxed ); }
+
+	// to be called by one thread once the work of the frame is done
+	void endFrame();
+	void reset();
+
+	long long getFrames() const;
+	// values of the last frame closed by endFrame()
+	long long getLastTime( profileTimer timer ) const;
+	long long getLastCount( profileCounter counter ) const;
+	long long getTotalTime( profileTimer timer ) const;
+	long long getTotalCount( profileCounter counter ) const;
+	long long getMaxTime( profileTimer timer ) const;
+	long long getHistogram( profileTimer timer, int bucket ) const;
+
+	// one line per timer and counter (last frame and mean), for the text overlay
+	std::string summary() const;
+	// every value and histogram as one JSON object, false if the file can not be written
+	void dumpJson( FILE * file ) const;
+	bool dumpJson( const char * path ) const;
+
+	// profiler of the PROFILE_ macros
+	static profiler & shared();
+};
+
+// Adds the time between its creation and its destruction to a timer
+class profileScope
+{
+private:
+	profileTimer timer;
+	std::chrono::steady_clock::time_point start;
+
+public:
+	profileScope( profileTimer timer ) : timer( timer ), start( std::chrono::steady_clock::now() ) {}
+	~profileScope(){
+		profiler::shared().addTime( this->timer, std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - this->start ).count() );
+	}
+};
+
+// The arguments are not evaluated when CURVES_PROFILE is not defined
+#ifdef CURVES_PROFILE
+#define PROFILE_JOIN2(a,b) a##b
+#define PROFILE_JOIN(a,b) PROFILE_JOIN2(a,b)
+#define PROFILE_SCOPE(timer) profileScope PROFILE_JOIN(profileScope, __LINE__)( timer )
+#define PROFILE_COUNT(counter, amount) profiler::shared().count( counter, amount )
+#define PROFILE_FRAME() profiler::shared().endFrame()
+#else
+#define PROFILE_SCOPE(timer) ((void)0)
+#define PROFILE_COUNT(counter, amount) ((void)0)
+#define PROFILE_FRAME() ((void)0)
+#endif
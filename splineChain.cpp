@@ -0,0 +1,169 @@
+#include "splineChain.h"
+
+bool isCubicChain( splineStore & curves ){
+	for( int i = 0; i < curves.size(); i++ ){
+		if( curves.getOffset( i+1 ) - curves.getOffset( i ) != 4 ){
+			return false;
+		}
+	}
+	return true;
+}
+
+// point after (or before) the joint giving the same derivative as the inner point of the other curve:
+// degreeFrom (joint - inner) = degreeTo (result - joint)
+static vec3 mirrorTangent( const vec3 & joint, const vec3 & inner, int degreeFrom, int degreeTo ){
+	return joint + ( joint - inner ) * ( degreeFrom/(double)degreeTo );
+}
+
+void enforceC1( splineStore & curves ){
+	for( int i = 1; i < curves.size(); i++ ){
+		curveView previous = curves[i-1], current = curves[i];
+		int last = previous.size()-1;
+		current[0] = previous[last];
+		if( last >= 2 && current.size() >= 3 ){
+			current[1] = mirrorTangent( current[0], previous[last-1], last, current.size()-1 );
+		}
+	}
+}
+
+void enforceC1( splineStore & curves, int curve, int controlPoint, int & first, int & last ){
+	first = last = curve;
+	curveView current = curves[curve];
+	int degree = current.size()-1;
+	bool hasNext = curve < curves.size()-1, hasPrevious = curve > 0;
+	if( hasNext && controlPoint == degree ){
+		// joint with the next curve
+		curveView next = curves[curve+1];
+		next[0] = current[degree];
+		if( degree >= 2 && next.size() >= 3 ){
+			next[1] = mirrorTangent( next[0], current[degree-1], degree, next.size()-1 );
+		}
+		last = curve+1;
+	}
+	else if( hasPrevious && controlPoint == 0 ){
+		curveView previous = curves[curve-1];
+		int previousDegree = previous.size()-1;
+		previous[previousDegree] = current[0];
+		if( degree >= 2 && previousDegree >= 2 ){
+			previous[previousDegree-1] = mirrorTangent( current[0], current[1], degree, previousDegree );
+		}
+		first = curve-1;
+	}
+	else if( hasNext && controlPoint == degree-1 && degree >= 2 && curves[curve+1].size() >= 3 ){
+		// tangent at the end
+		curveView next = curves[curve+1];
+		next[1] = mirrorTangent( next[0], current[degree-1], degree, next.size()-1 );
+		last = curve+1;
+	}
+	else if( hasPrevious && controlPoint == 1 && degree >= 2 && curves[curve-1].size() >= 3 ){
+		curveView previous = curves[curve-1];
+		int previousDegree = previous.size()-1;
+		previous[previousDegree-1] = mirrorTangent( current[0], current[1], degree, previousDegree );
+		first = curve-1;
+	}
+}
+
+splineChainSolver::splineChainSolver( double tolerance ) {
+	this->tolerance = tolerance;
+}
+
+void splineChainSolver::setTolerance( double tolerance ) {
+	this->tolerance = tolerance;
+}
+double splineChainSolver::getTolerance() const {
+	return this->tolerance;
+}
+
+// tangents first .. last (Thomas algorithm), the tangents around the range are taken from derivatives
+void splineChainSolver::solveRange( int first, int last, vec3 * result ) {
+	int n = this->knots.size()-1;
+	const std::vector<vec3> & k = this->knots;
+	int amount = last-first+1;
+	this->diagonal.resize( amount );
+	this->rightSide.resize( amount );
+	for( int i = first; i <= last; i++ ){
+		double center = ( i == 0 || i == n ) ? 2 : 4;
+		vec3 value = i == 0 ? ( k[1] - k[0] )*3. : ( i == n ? ( k[n] - k[n-1] )*3. : ( k[i+1] - k[i-1] )*3. );
+		if( i == first && i > 0 ){
+			value -= this->derivatives[i-1];
+		}
+		if( i == last && i < n ){
+			value -= this->derivatives[i+1];
+		}
+		// elimination of the tangent i-1 (coefficient 1 below and above the diagonal)
+		if( i > first ){
+			center -= this->diagonal[i-first-1];
+			value -= this->rightSide[i-first-1];
+		}
+		this->diagonal[i-first] = 1/center;
+		this->rightSide[i-first] = value/center;
+	}
+	result[amount-1] = this->rightSide[amount-1];
+	for( int j = amount-2; j >= 0; j-- ){
+		result[j] = this->rightSide[j] - result[j+1]*this->diagonal[j];
+	}
+}
+
+void splineChainSolver::writeCurves( splineStore & curves, int first, int last ) const {
+	for( int i = first; i <= last; i++ ){
+		curveView curve = curves[i];
+		curve[0] = this->knots[i];
+		curve[1] = this->knots[i] + this->derivatives[i]/3.;
+		curve[2] = this->knots[i+1] - this->derivatives[i+1]/3.;
+		curve[3] = this->knots[i+1];
+	}
+}
+
+bool splineChainSolver::solve( splineStore & curves ) {
+	if( !isCubicChain( curves ) ){
+		return false;
+	}
+	int n = curves.size();
+	this->knots.resize( n > 0 ? n+1 : 0 );
+	this->derivatives.assign( this->knots.size(), vec3() );
+	if( n == 0 ){
+		return true;
+	}
+	for( int i = 0; i < n; i++ ){
+		this->knots[i] = curves[i][0];
+	}
+	this->knots[n] = curves[n-1][3];
+	this->solveRange( 0, n, &this->derivatives[0] );
+	this->writeCurves( curves, 0, n-1 );
+	return true;
+}
+
+void splineChainSolver::moveKnot( splineStore & curves, int knot, const vec3 & position, int & first, int & last ) {
+	int n = this->knots.size()-1;
+	this->knots[knot] = position;
+	// the window grows until the tangents at its ends do not move (or it covers the chain)
+	int begin, end;
+	for( int half = 8; ; half *= 2 ){
+		begin = knot-half < 0 ? 0 : knot-half;
+		end = knot+half > n ? n : knot+half;
+		this->window.resize( end-begin+1 );
+		this->solveRange( begin, end, &this->window[0] );
+		bool isBeginStill = begin == 0 || ( this->window[0] - this->derivatives[begin] ).norme() <= this->tolerance;
+		bool isEndStill = end == n || ( this->window[end-begin] - this->derivatives[end] ).norme() <= this->tolerance;
+		if( isBeginStill && isEndStill ){
+			break;
+		}
+	}
+	for( int i = begin; i <= end; i++ ){
+		this->derivatives[i] = this->window[i-begin];
+	}
+	// curve i depends on the joints and tangents i and i+1
+	first = begin > 0 ? begin-1 : 0;
+	last = end < n ? end : n-1;
+	this->writeCurves( curves, first, last );
+}
+
+int splineChainSolver::getAmountKnots() const {
+	return this->knots.size();
+}
+const vec3 & splineChainSolver::getKnot( int knot ) const {
+	return this->knots[knot];
+}
+const vec3 & splineChainSolver::getDerivative( int knot ) const {
+	return this->derivatives[knot];
+}
@@ -0,0 +1,57 @@
+#include <vector>
+#include "vec3.h"
+#include "splineStore.h"
+
+#pragma once
+
+// Continuity of a chain of Bezier curves stored one after the other (curve i ends where curve i+1 starts)
+
+// true when every curve of the store is a cubic segment (4 control points)
+bool isCubicChain( splineStore & curves );
+
+// C1 over the whole chain in one pass from the first curve to the last: each curve starts at the end point of the
+// previous one and its second point mirrors the one before last of the previous curve. The first curve is kept
+void enforceC1( splineStore & curves );
+// C1 around one edited point: the joint or the tangent the point belongs to is copied (mirrored) on the
+// neighbouring curve, the edited side is kept. first and last receive the curves changed (the edited one included)
+void enforceC1( splineStore & curves, int curve, int controlPoint, int & first, int & last );
+
+/**
+ *	C2 chain of cubic segments interpolating its joints K0 .. Kn (K0 = P0 of the first curve, Ki = P3 of curve i-1).
+ * The tangents Di at the joints solve the tridiagonal system of the natural cubic spline (uniform parameters)
+ *   2 D0 + D1 = 3 (K1 - K0),   D(i-1) + 4 Di + D(i+1) = 3 (K(i+1) - K(i-1)),   D(n-1) + 2 Dn = 3 (Kn - K(n-1))
+ * with the Thomas algorithm in O(n), and curve i becomes Ki, Ki + Di/3, K(i+1) - D(i+1)/3, K(i+1).
+ * Moving one joint changes the tangents everywhere, but the change decays by 2-sqrt(3) (about 0.27) per joint:
+ * moveKnot() only solves a window around the joint, with the tangents outside it fixed, and widens it until the
+ * change at its ends is below the tolerance. An edit in a chain of 100k curves touches a few tens of curves.
+ *
+ */
+class splineChainSolver
+{
+private:
+	std::vector<vec3> knots;
+	std::vector<vec3> derivatives;
+	std::vector<vec3> window;		// tangents solved by moveKnot()
+	std::vector<double> diagonal;		// Thomas forward sweep
+	std::vector<vec3> rightSide;
+	double tolerance;
+
+	void solveRange( int first, int last, vec3 * result );
+	void writeCurves( splineStore & curves, int first, int last ) const;
+
+public:
+	splineChainSolver( double tolerance = 1e-9 );
+
+	void setTolerance( double tolerance );
+	double getTolerance() const;
+
+	// reads the joints of the chain, solves every tangent and writes every curve. false (and nothing written)
+	// if the chain is not made of cubic segments
+	bool solve( splineStore & curves );
+	// moves joint k of the chain solved by solve(): first and last receive the curves written
+	void moveKnot( splineStore & curves, int knot, const vec3 & position, int & first, int & last );
+
+	int getAmountKnots() const;
+	const vec3 & getKnot( int knot ) const;
+	const vec3 & getDerivative( int knot ) const;
+};
@@ -0,0 +1,73 @@
+#include "splineStore.h"
+
+splineStore::splineStore() {
+	this->offsets.push_back( 0 );
+}
+
+// page with room for amount more points, a new one when the last page is full
+std::vector<vec3> & splineStore::pageFor( int amount ) {
+	if( this->pages.empty() || (int)( this->pages.back().capacity() - this->pages.back().size() ) < amount ){
+		this->pages.push_back( std::vector<vec3>() );
+		this->pages.back().reserve( amount > pageSize ? amount : pageSize );
+	}
+	return this->pages.back();
+}
+
+void splineStore::reserve( int amountCurves, int amountPoints ) {
+	this->offsets.reserve( amountCurves+1 );
+	this->starts.reserve( amountCurves );
+	if( amountPoints > this->getAmountPoints() ){
+		this->pageFor( amountPoints - this->getAmountPoints() );
+	}
+}
+
+void splineStore::clear() {
+	if( !this->pages.empty() ){
+		this->pages.resize( 1 );
+		this->pages[0].clear();
+	}
+	this->starts.clear();
+	this->offsets.assign( 1, 0 );
+}
+
+int splineStore::addCurve( const vec3 * controlPoints, int amount ) {
+	std::vector<vec3> & page = this->pageFor( amount );
+	this->starts.push_back( page.data() + page.size() );
+	page.insert( page.end(), controlPoints, controlPoints + amount );
+	this->offsets.push_back( this->offsets.back() + amount );
+	return this->size()-1;
+}
+
+int splineStore::addCurve( const std::deque<vec3> & controlPoints ) {
+	std::vector<vec3> & page = this->pageFor( controlPoints.size() );
+	this->starts.push_back( page.data() + page.size() );
+	page.insert( page.end(), controlPoints.begin(), controlPoints.end() );
+	this->offsets.push_back( this->offsets.back() + controlPoints.size() );
+	return this->size()-1;
+}
+
+int splineStore::addView( const curveView & controlPoints ) {
+	this->starts.push_back( controlPoints.data() );
+	this->offsets.push_back( this->offsets.back() + controlPoints.size() );
+	return this->size()-1;
+}
+
+int splineStore::size() const {
+	return this->offsets.size()-1;
+}
+
+int splineStore::getAmountPoints() const {
+	return this->offsets.back();
+}
+
+int splineStore::getOffset( int curve ) const {
+	return this->offsets[curve];
+}
+
+curveView splineStore::getCurve( int curve ) {
+	return curveView( this->starts[curve], this->offsets[curve+1] - this->offsets[curve] );
+}
+
+curveView splineStore::operator[]( int curve ) {
+	return this->getCurve( curve );
+}
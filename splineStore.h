@@ -0,0 +1,52 @@
+#include <deque>
+#include <vector>
+#include "vec3.h"
+#include "curveView.h"
+
+#pragma once
+
+/**
+ *	Control points of many curves in large contiguous pages: curve i owns offsets[i+1] - offsets[i] points stored
+ * one after the other in a page, and the curves of a page follow each other in memory. Iterating the curves
+ * walks the pages in order, and the evaluators receive curveViews into them instead of copies.
+ * A page is allocated with its final capacity (pageSize points, or the size of a larger curve) and never grows:
+ * adding a curve appends its points to the last page or starts a new one, so the views of the other curves stay
+ * valid. Editing a point writes in place. reserve() puts the points still to come in one page.
+ * addView() adds a curve whose points stay where they are (a mapped curve file): nothing is copied, the points
+ * must outlive the store and edits write to them.
+ *
+ */
+class splineStore
+{
+private:
+	std::vector< std::vector<vec3> > pages;	// capacity fixed at creation, a page never reallocates
+	std::vector<vec3 *> starts;		// first point of each curve
+	std::vector<int> offsets;	// size()+1 entries, offsets[size()] is the amount of points
+
+	std::vector<vec3> & pageFor( int amount );
+
+public:
+	// points of a page, 1.5 MB
+	static const int pageSize = 1 << 16;
+
+	splineStore();
+
+	void reserve( int amountCurves, int amountPoints );
+	// forgets the curves, the first page is kept for the next ones
+	void clear();
+
+	// appends a curve and returns its index
+	int addCurve( const vec3 * controlPoints, int amount );
+	int addCurve( const std::deque<vec3> & controlPoints );
+	// appends a curve without copying its points
+	int addView( const curveView & controlPoints );
+
+	// amount of curves
+	int size() const;
+	int getAmountPoints() const;
+	// points before the curve, over every page
+	int getOffset( int curve ) const;
+
+	curveView getCurve( int curve );
+	curveView operator[]( int curve );
+};
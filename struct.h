@@ -1,6 +1,9 @@
 #include <iostream>
+#include "vec3.h"
 using namespace std ;
 
+#pragma once
+
 
 
 # define M_PI		3.14159265358979323846
@@ -9,44 +12,38 @@ using namespace std ;
 
 /******************* point3 ******************/
 
-class	point3{   
-
-public:
-
-	double      x;
-
-	double      y;
-
-	double      z;
-
-	
-
-	point3();                                        // (0,0,0) par defaut
-
-	point3(const double X,const double Y,const double Z);
-
-	
-
-	bool         operator==(const point3 &op)const;
-
-	point3&     operator=(const point3 &op);
-
-	point3      operator+(const point3 &op)const;
-
-	point3&     operator*=(const double op);          //produit par un scalaire
-
-	point3      operator*(const double op)const;                 //idem
-
-	point3&     operator/=(const double op);         //division par un scalaire
-
-	point3      operator/(const double op)const;                 //idem
-	
-
-	void		Permutation(point3 *A, point3 *B);	     // Permutation de deux points
-
-	friend ostream&  operator<<(ostream& p, point3 op);
-
-	friend istream&  operator>>(istream& p, point3 &op);
-
-};
-
+// point3 is the double vector3 (see vec3.h), the geometry of the programs has a single point type
+
+typedef vec3	point3;
+
+
+
+template<typename T>
+void		Permutation(vector3<T> *A, vector3<T> *B)	     // Permutation de deux points
+{ vector3<T> PEch;
+  PEch = (*A);
+  (*A) = (*B);
+  (*B) = PEch;
+}
+
+template<typename T>
+ostream&  operator<<(ostream& p, const vector3<T> & op)
+{
+	p << "(" << op.getX() <<", " << op.getY() << "," << op.getZ()  << ")";
+	return(p);
+}
+
+template<typename T>
+istream&  operator>>(istream& p, vector3<T> &op)
+{
+	T x, y, z;
+	cout << "Entrez x:";
+	p >> x;
+	cout << "Entrez y:";
+	p >> y;
+	cout << "Entrez z:";
+	p >> z;
+	op.set( x, y, z );
+
+	return (p);
+}
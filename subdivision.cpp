@@ -0,0 +1,256 @@
+#include "subdivision.h"
+#include <stdio.h>
+
+template<typename T>
+chaikinEngineT<T>::chaikinEngineT() {
+}
+
+template<typename T>
+int chaikinEngineT<T>::outputSize( int amountPoints, int levels ) {
+	return amountPoints << levels;
+}
+
+// corner cutting of the edge i of the closed polygon source (n points), written at 2i and 2i+1 of destination
+template<typename T>
+static inline void chaikinEdge( vector3<T> * source, int n, int i, vector3<T> * destination ){
+	const T weightNear = 3/4., weightFar = 1/4.;
+	vector3<T> & a = source[i];
+	vector3<T> & b = source[i+1 < n ? i+1 : 0];
+	destination[2*i].set( a.getX()*weightNear + b.getX()*weightFar, a.getY()*weightNear + b.getY()*weightFar, a.getZ()*weightNear + b.getZ()*weightFar );
+	destination[2*i+1].set( b.getX()*weightNear + a.getX()*weightFar, b.getY()*weightNear + a.getY()*weightFar, b.getZ()*weightNear + a.getZ()*weightFar );
+}
+
+// one level of corner cutting from source (n points) to destination (2n points)
+template<typename T>
+static void chaikinLevel( vector3<T> * source, int n, vector3<T> * destination ){
+	for( int i = 0; i < n; i++ ){
+		chaikinEdge( source, n, i, destination );
+	}
+}
+
+template<typename T>
+void chaikinEngineT<T>::subdivide( vector3<T> * controlPoints, int amountPoints, int levels, vector3<T> * output ) {
+	if( levels == 0 ){
+		for( int i = 0; i < amountPoints; i++ ){
+			output[i] = controlPoints[i];
+		}
+		return;
+	}
+	int size = outputSize( amountPoints, levels );
+	if( this->scratch.size() < size ){
+		this->scratch.resize( size );
+	}
+
+	// the last level writes into output, the ones before alternate with the scratch buffer
+	vector3<T> * source = controlPoints;
+	vector3<T> * destination = levels % 2 == 1 ? output : &this->scratch[0];
+	int n = amountPoints;
+	for( int level = 0; level < levels; level++ ){
+		chaikinLevel( source, n, destination );
+		n *= 2;
+		source = destination;
+		destination = destination == output ? &this->scratch[0] : output;
+	}
+}
+
+template<typename T>
+void chaikinEngineT<T>::subdivide( std::deque< vector3<T> > & controlPoints, int levels, std::vector< vector3<T> > & output ) {
+	// a deque is not contiguous, the control points are copied first
+	int amountPoints = controlPoints.size();
+	output.resize( outputSize( amountPoints, levels ) );
+	this->input.assign( controlPoints.begin(), controlPoints.end() );
+	this->subdivide( &this->input[0], amountPoints, levels, &output[0] );
+}
+
+// the two precisions of vector3
+template class chaikinEngineT<double>;
+template class chaikinEngineT<float>;
+
+template<typename T>
+chaikinIncrementalT<T>::chaikinIncrementalT() {
+}
+
+template<typename T>
+void chaikinIncrementalT<T>::build( std::deque< vector3<T> > & controlPoints, int amountLevels ) {
+	this->levels.resize( amountLevels+1 );
+	this->levels[0].assign( controlPoints.begin(), controlPoints.end() );
+	this->buildLevels( amountLevels );
+}
+
+template<typename T>
+void chaikinIncrementalT<T>::build( const curveViewT<T> & controlPoints, int amountLevels ) {
+	this->levels.resize( amountLevels+1 );
+	this->levels[0].assign( controlPoints.begin(), controlPoints.end() );
+	this->buildLevels( amountLevels );
+}
+
+// levels 1 to amountLevels from levels[0]
+template<typename T>
+void chaikinIncrementalT<T>::buildLevels( int amountLevels ) {
+	for( int level = 1; level <= amountLevels; level++ ){
+		int n = this->levels[level-1].size();
+		this->levels[level].resize( 2*n );
+		chaikinLevel( &this->levels[level-1][0], n, &this->levels[level][0] );
+	}
+}
+
+template<typename T>
+bool chaikinIncrementalT<T>::isBuilt() const {
+	return !this->levels.empty();
+}
+
+template<typename T>
+int chaikinIncrementalT<T>::getAmountPoints() const {
+	return this->levels.empty() ? 0 : this->levels[0].size();
+}
+
+template<typename T>
+int chaikinIncrementalT<T>::getAmountLevels() const {
+	return this->levels.empty() ? 0 : this->levels.size()-1;
+}
+
+// recomputes the edges [begin, begin+count) (modulo the size) of level-1 into level
+template<typename T>
+void chaikinIncrementalT<T>::recompute( int level, int begin, int count ) {
+	std::vector< vector3<T> > & source = this->levels[level-1];
+	int n = source.size();
+	for( int k = 0; k < count; k++ ){
+		chaikinEdge( &source[0], n, (begin+k) % n, &this->levels[level][0] );
+	}
+}
+
+template<typename T>
+void chaikinIncrementalT<T>::update( int index, vector3<T> point ) {
+	this->levels[0][index] = point;
+
+	// window of changed points at the current level: [begin, begin+count) modulo its size
+	int begin = index, count = 1;
+	for( int level = 1; level < this->levels.size(); level++ ){
+		int n = this->levels[level-1].size();
+		// the edges touching a changed point start one point before the window
+		int edgeBegin = (begin-1+n) % n;
+		int edgeCount = count+1 < n ? count+1 : n;
+		this->recompute( level, edgeBegin, edgeCount );
+		begin = 2*edgeBegin;
+		count = 2*edgeCount;
+	}
+}
+
+template<typename T>
+std::vector< vector3<T> > & chaikinIncrementalT<T>::getResult() {
+	return this->levels.back();
+}
+
+template<typename T>
+chaikinStreamT<T>::chaikinStreamT( std::deque< vector3<T> > & controlPoints, int levels ) {
+	this->controlPoints = &controlPoints;
+	this->amountControlPoints = controlPoints.size();
+	this->stages.resize( levels );
+	this->reset();
+}
+
+template<typename T>
+chaikinStreamT<T>::chaikinStreamT( const curveViewT<T> & controlPoints, int levels ) {
+	this->controlPoints = NULL;
+	this->view = controlPoints;
+	this->amountControlPoints = controlPoints.size();
+	this->stages.resize( levels );
+	this->reset();
+}
+
+template<typename T>
+void chaikinStreamT<T>::reset() {
+	this->nextControlPoint = 0;
+	for( int i = 0; i < this->stages.size(); i++ ){
+		this->stages[i].isStarted = false;
+		this->stages[i].hasPending = false;
+		this->stages[i].isWrapped = false;
+	}
+}
+
+// next point of the given level, false when the level is complete
+template<typename T>
+bool chaikinStreamT<T>::pull( int level, vector3<T> & point ) {
+	if( level == 0 ){
+		if( this->nextControlPoint >= this->amountControlPoints ){
+			return false;
+		}
+		point = this->controlPoints != NULL ? (*this->controlPoints)[this->nextControlPoint] : this->view[this->nextControlPoint];
+		this->nextControlPoint++;
+		return true;
+	}
+
+	stage & current = this->stages[level-1];
+	if( current.hasPending ){
+		current.hasPending = false;
+		point = current.pending;
+		return true;
+	}
+	if( !current.isStarted ){
+		if( !this->pull( level-1, current.first ) ){
+			return false;
+		}
+		current.previous = current.first;
+		current.isStarted = true;
+	}
+
+	vector3<T> source;
+	if( !this->pull( level-1, source ) ){
+		// the source is complete: closing edge from the last point to the first one, once
+		if( current.isWrapped ){
+			return false;
+		}
+		current.isWrapped = true;
+		source = current.first;
+	}
+	vector3<T> & a = current.previous;
+	const T weightNear = 3/4., weightFar = 1/4.;
+	point.set( a.getX()*weightNear + source.getX()*weightFar, a.getY()*weightNear + source.getY()*weightFar, a.getZ()*weightNear + source.getZ()*weightFar );
+	current.pending.set( source.getX()*weightNear + a.getX()*weightFar, source.getY()*weightNear + a.getY()*weightFar, source.getZ()*weightNear + a.getZ()*weightFar );
+	current.hasPending = true;
+	current.previous = source;
+	return true;
+}
+
+template<typename T>
+bool chaikinStreamT<T>::next( vector3<T> & point ) {
+	return this->pull( this->stages.size(), point );
+}
+
+template<typename T>
+long long chaikinStreamT<T>::size() const {
+	return (long long)this->amountControlPoints << this->stages.size();
+}
+
+template class chaikinIncrementalT<double>;
+template class chaikinIncrementalT<float>;
+template class chaikinStreamT<double>;
+template class chaikinStreamT<float>;
+
+double chaikinLength( std::deque<vec3> & controlPoints, int levels ){
+	chaikinStream stream( controlPoints, levels );
+	vec3 first, previous, point;
+	if( !stream.next( first ) ){
+		return 0;
+	}
+	double length = 0;
+	previous = first;
+	while( stream.next( point ) ){
+		length += point.soustraction( previous ).norme();
+		previous = point;
+	}
+	return length + first.soustraction( previous ).norme();
+}
+
+bool writeChaikin( std::deque<vec3> & controlPoints, int levels, const char * path ){
+	FILE * file = fopen( path, "w" );
+	if( file == NULL ){
+		return false;
+	}
+	chaikinStream stream( controlPoints, levels );
+	vec3 point;
+	while( stream.next( point ) ){
+		fprintf( file, "%.17g %.17g %.17g\n", point.getX(), point.getY(), point.getZ() );
+	}
+	return fclose( file ) == 0;
+}
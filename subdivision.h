@@ -0,0 +1,144 @@
+#include <deque>
+#include <vector>
+#include "vec3.h"
+#include "curveView.h"
+
+#pragma once
+
+// Subdivision kernels shared by the GLUT programs and the benchmark (no OpenGL dependency).
+// chaikinPoint, chaikin and the engines are templated on the precision of vector3 (vec3 or vec3f),
+// chaikinLength and writeChaikin work in double
+
+// point at 3/4 of P1 and 1/4 of P2 (Chaikin corner cutting)
+template<typename T>
+vector3<T> chaikinPoint( const vector3<T> & p1, const vector3<T> & p2 ){
+    return p1*(T)(3/4.) + p2*(T)(1/4.);
+}
+// subdivide the closed polygon controlPoints from level up to maxLevel
+template<typename T>
+std::deque< vector3<T> > chaikin( const std::deque< vector3<T> > & controlPoints, int level, int maxLevel ){
+    if( level == maxLevel ){
+        return controlPoints;
+    }
+    else{
+        std::deque< vector3<T> > result;
+        for( int i=0; i<controlPoints.size(); i++ ){
+            const vector3<T> & a = controlPoints[i];
+            const vector3<T> & b = controlPoints[(i+1)%controlPoints.size()];
+            result.push_back( chaikinPoint( a, b ) );
+            result.push_back( chaikinPoint( b, a ) );
+        }
+        return chaikin( result, level+1, maxLevel );
+    }
+}
+
+/**
+ *	Chaikin subdivision of a closed polygon without allocation in steady state.
+ * The size of the result (amountPoints * 2^levels) is known up front: the levels alternate
+ * between the output and one scratch buffer of the same size, chosen so that the last level
+ * lands in the output. The peak memory is twice the final output.
+ * Instantiated for vec3 (chaikinEngine) and vec3f (chaikinEngineF).
+ *
+ */
+template<typename T>
+class chaikinEngineT
+{
+private:
+	std::vector< vector3<T> > scratch;
+	std::vector< vector3<T> > input;	// contiguous copy of a deque of control points
+
+public:
+	chaikinEngineT();
+
+	static int outputSize( int amountPoints, int levels );
+
+	// output must hold outputSize( amountPoints, levels ) points
+	void subdivide( vector3<T> * controlPoints, int amountPoints, int levels, vector3<T> * output );
+	// output is resized (it only reallocates when it grows)
+	void subdivide( std::deque< vector3<T> > & controlPoints, int levels, std::vector< vector3<T> > & output );
+};
+
+typedef chaikinEngineT<double> chaikinEngine;
+typedef chaikinEngineT<float> chaikinEngineF;
+
+/**
+ *	Chaikin subdivision of a closed polygon that keeps every level, so that moving one control point
+ * only recomputes the window of each level it influences: a changed range of w points at one level
+ * changes 2w+2 points at the next, so an edit costs O(2^levels) instead of O(n * 2^levels).
+ * The result is identical to chaikin(). Instantiated for vec3 (chaikinIncremental) and vec3f (chaikinIncrementalF).
+ *
+ */
+template<typename T>
+class chaikinIncrementalT
+{
+private:
+	std::vector< std::vector< vector3<T> > > levels;	// levels[0] the control points, levels.back() the result
+
+	void recompute( int level, int begin, int count );
+	void buildLevels( int amountLevels );
+
+public:
+	chaikinIncrementalT();
+
+	// full subdivision, keeping each level
+	void build( std::deque< vector3<T> > & controlPoints, int amountLevels );
+	void build( const curveViewT<T> & controlPoints, int amountLevels );
+	bool isBuilt() const;
+	int getAmountPoints() const;
+	int getAmountLevels() const;
+
+	// moves the control point index and recomputes the affected windows
+	void update( int index, vector3<T> point );
+
+	std::vector< vector3<T> > & getResult();
+};
+
+typedef chaikinIncrementalT<double> chaikinIncremental;
+typedef chaikinIncrementalT<float> chaikinIncrementalF;
+
+/**
+ *	Lazy generator of the points of level k of the Chaikin subdivision of a closed polygon, in order.
+ * Each level is a stage pulling the points of the level below one at a time and cutting the edge
+ * between the previous point and the new one; a stage only remembers the first and previous points
+ * of its source and the second point of the last cut edge. The state is O(k) and no level is ever
+ * held in memory, the points are the same as chaikin( controlPoints, 0, k ).
+ * Instantiated for vec3 (chaikinStream) and vec3f (chaikinStreamF).
+ *
+ */
+template<typename T>
+class chaikinStreamT
+{
+private:
+	struct stage
+	{
+		vector3<T> first, previous, pending;
+		bool isStarted, hasPending, isWrapped;
+	};
+
+	std::deque< vector3<T> > * controlPoints;	// NULL when reading a view
+	curveViewT<T> view;
+	int amountControlPoints;
+	int nextControlPoint;
+	std::vector<stage> stages;	// stages[L-1] produces level L
+
+	bool pull( int level, vector3<T> & point );
+
+public:
+	chaikinStreamT( std::deque< vector3<T> > & controlPoints, int levels );
+	chaikinStreamT( const curveViewT<T> & controlPoints, int levels );
+
+	// restarts from the first point
+	void reset();
+	// next point of the last level, false when every point was produced
+	bool next( vector3<T> & point );
+	// amount of points produced by a full pass
+	long long size() const;
+};
+
+typedef chaikinStreamT<double> chaikinStream;
+typedef chaikinStreamT<float> chaikinStreamF;
+
+// length of the closed level-k Chaikin polygon, without materializing it
+double chaikinLength( std::deque<vec3> & controlPoints, int levels );
+// writes the level-k Chaikin points as "x y z" lines, false if the file can not be written
+bool writeChaikin( std::deque<vec3> & controlPoints, int levels, const char * path );
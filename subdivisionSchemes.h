@@ -0,0 +1,213 @@
+#include <deque>
+#include <vector>
+#include "vec3.h"
+#include "curveView.h"
+
+#pragma once
+
+/**
+ *	Subdivision schemes as compile-time stencils for subdivisionEngine.
+ * A stencil provides
+ *   static int refinedSize( int n, bool closed );	// points after one level
+ *   static int workSize( int n, bool closed );		// points of destination used while refining
+ *   template<typename T> static void refine( vector3<T> * source, int n, bool closed, vector3<T> * destination );
+ * The boundary (wrap-around or end points) is handled outside the inner loops, which do not branch.
+ * The weights are rounded to the precision of the points (vec3 or vec3f).
+ *
+ */
+
+// r = a*p + b*q
+template<typename T>
+inline void combine( vector3<T> & r, T a, vector3<T> & p, T b, vector3<T> & q ){
+	r.set( p.getX()*a + q.getX()*b, p.getY()*a + q.getY()*b, p.getZ()*a + q.getZ()*b );
+}
+
+// r = a*p + b*q + c*s
+template<typename T>
+inline void combine( vector3<T> & r, T a, vector3<T> & p, T b, vector3<T> & q, T c, vector3<T> & s ){
+	r.set( p.getX()*a + q.getX()*b + s.getX()*c,
+	       p.getY()*a + q.getY()*b + s.getY()*c,
+	       p.getZ()*a + q.getZ()*b + s.getZ()*c );
+}
+
+// r = a*p + b*q + c*s + d*t
+template<typename T>
+inline void combine( vector3<T> & r, T a, vector3<T> & p, T b, vector3<T> & q, T c, vector3<T> & s, T d, vector3<T> & t ){
+	r.set( p.getX()*a + q.getX()*b + s.getX()*c + t.getX()*d,
+	       p.getY()*a + q.getY()*b + s.getY()*c + t.getY()*d,
+	       p.getZ()*a + q.getZ()*b + s.getZ()*c + t.getZ()*d );
+}
+
+// Chaikin corner cutting (quadratic B-spline), the same points as chaikin() on closed polygons.
+// Open polygons keep their end points.
+struct chaikinStencil
+{
+	static int refinedSize( int n, bool closed ){
+		return 2*n;
+	}
+	static int workSize( int n, bool closed ){
+		return refinedSize( n, closed );
+	}
+
+	template<typename T>
+	static void refine( vector3<T> * source, int n, bool closed, vector3<T> * destination ){
+		const T weightNear = 3/4., weightFar = 1/4.;
+		vector3<T> * out = closed ? destination : destination+1;
+		for( int i = 0; i < n-1; i++ ){
+			combine( out[2*i], weightNear, source[i], weightFar, source[i+1] );
+			combine( out[2*i+1], weightNear, source[i+1], weightFar, source[i] );
+		}
+		if( closed ){
+			combine( out[2*n-2], weightNear, source[n-1], weightFar, source[0] );
+			combine( out[2*n-1], weightNear, source[0], weightFar, source[n-1] );
+		}
+		else{
+			destination[0] = source[0];
+			destination[2*n-1] = source[n-1];
+		}
+	}
+};
+
+// Lane-Riesenfeld: every point doubled, then Degree passes of averaging of neighbours.
+// The limit is the uniform B-spline of the given degree (Degree 2 is Chaikin). Open polygons lose Degree points per level.
+template<int Degree>
+struct laneRiesenfeldStencil
+{
+	static_assert( Degree >= 1, "laneRiesenfeldStencil needs a degree of at least 1" );
+
+	static int refinedSize( int n, bool closed ){
+		return closed ? 2*n : 2*n - Degree;
+	}
+	static int workSize( int n, bool closed ){
+		return closed ? 2*n : 2*n - 1;
+	}
+
+	template<typename T>
+	static void refine( vector3<T> * source, int n, bool closed, vector3<T> * destination ){
+		const T half = 1/2.;
+		// doubling and first averaging pass together: the points and the middles of the edges
+		for( int i = 0; i < n-1; i++ ){
+			destination[2*i] = source[i];
+			combine( destination[2*i+1], half, source[i], half, source[i+1] );
+		}
+		destination[2*n-2] = source[n-1];
+		int m = 2*n-1;
+		if( closed ){
+			combine( destination[2*n-1], half, source[n-1], half, source[0] );
+			m = 2*n;
+		}
+
+		for( int pass = 1; pass < Degree; pass++ ){
+			vector3<T> first = destination[0];
+			for( int i = 0; i < m-1; i++ ){
+				combine( destination[i], half, destination[i], half, destination[i+1] );
+			}
+			if( closed ){
+				combine( destination[m-1], half, destination[m-1], half, first );
+			}
+			else{
+				m--;
+			}
+		}
+	}
+};
+
+// Dyn-Levin-Gregory 4-point interpolating scheme (w = 1/16): the points are kept and each edge gets
+// ( -P(i-1) + 9 P(i) + 9 P(i+1) - P(i+2) ) / 16. The end edges of open polygons use the quadratic ( 3, 6, -1 ) / 8.
+struct fourPointStencil
+{
+	static int refinedSize( int n, bool closed ){
+		return closed ? 2*n : 2*n - 1;
+	}
+	static int workSize( int n, bool closed ){
+		return refinedSize( n, closed );
+	}
+
+	template<typename T>
+	static void refine( vector3<T> * source, int n, bool closed, vector3<T> * destination ){
+		const T outer = -1/16., inner = 9/16., half = 1/2.;
+		for( int i = 0; i < n; i++ ){
+			destination[2*i] = source[i];
+		}
+		// edges whose four points do not wrap
+		for( int i = 1; i < n-2; i++ ){
+			combine( destination[2*i+1], outer, source[i-1], inner, source[i], inner, source[i+1], outer, source[i+2] );
+		}
+		if( closed ){
+			// the edges that wrap around (fewer on tiny polygons)
+			int wrapping[3] = { 0, n-2, n-1 };
+			for( int k = 0; k < 3; k++ ){
+				int i = wrapping[k];
+				if( i < 0 || (k > 0 && i <= wrapping[k-1]) ){
+					continue;
+				}
+				combine( destination[2*i+1], outer, source[(i-1+n)%n], inner, source[i], inner, source[(i+1)%n], outer, source[(i+2)%n] );
+			}
+		}
+		else if( n == 2 ){
+			combine( destination[1], half, source[0], half, source[1] );
+		}
+		else if( n > 2 ){
+			const T weightEnd = 3/8., weightNext = 6/8., weightFar = -1/8.;
+			combine( destination[1], weightEnd, source[0], weightNext, source[1], weightFar, source[2] );
+			combine( destination[2*n-3], weightEnd, source[n-1], weightNext, source[n-2], weightFar, source[n-3] );
+		}
+	}
+};
+
+/**
+ *	Subdivision of open or closed polygons with a compile-time stencil.
+ * Two buffers are alternated between the levels and kept between calls (no allocation in steady state).
+ * T is the precision of the points: subdivisionEngine<Stencil, float> works on vec3f.
+ *
+ */
+template<typename Stencil, typename T = double>
+class subdivisionEngine
+{
+private:
+	std::vector< vector3<T> > buffers[2];
+	std::vector< vector3<T> > input;	// contiguous copy of a deque of control points
+
+public:
+	static int outputSize( int amountPoints, bool closed, int levels ){
+		for( int level = 0; level < levels; level++ ){
+			amountPoints = Stencil::refinedSize( amountPoints, closed );
+		}
+		return amountPoints;
+	}
+
+	// the returned buffer holds the result until the next call
+	std::vector< vector3<T> > & subdivide( vector3<T> * controlPoints, int amountPoints, bool closed, int levels ){
+		// both buffers reserved for the largest level
+		int largest = amountPoints, n = amountPoints;
+		for( int level = 0; level < levels; level++ ){
+			int work = Stencil::workSize( n, closed );
+			largest = work > largest ? work : largest;
+			n = Stencil::refinedSize( n, closed );
+		}
+		this->buffers[0].reserve( largest );
+		this->buffers[1].reserve( largest );
+
+		this->buffers[0].assign( controlPoints, controlPoints + amountPoints );
+		int current = 0;
+		n = amountPoints;
+		for( int level = 0; level < levels; level++ ){
+			int refined = Stencil::refinedSize( n, closed );
+			this->buffers[1-current].resize( Stencil::workSize( n, closed ) );
+			Stencil::refine( &this->buffers[current][0], n, closed, &this->buffers[1-current][0] );
+			this->buffers[1-current].resize( refined );
+			n = refined;
+			current = 1-current;
+		}
+		return this->buffers[current];
+	}
+
+	std::vector< vector3<T> > & subdivide( std::deque< vector3<T> > & controlPoints, bool closed, int levels ){
+		this->input.assign( controlPoints.begin(), controlPoints.end() );
+		return this->subdivide( &this->input[0], this->input.size(), closed, levels );
+	}
+
+	std::vector< vector3<T> > & subdivide( const curveViewT<T> & controlPoints, bool closed, int levels ){
+		return this->subdivide( controlPoints.data(), controlPoints.size(), closed, levels );
+	}
+};
@@ -0,0 +1,84 @@
+#include "tessellationCache.h"
+#include "profiler.h"
+
+template<typename T>
+tessellationCacheT<T>::tessellationCacheT() {
+}
+
+template<typename T>
+void tessellationCacheT<T>::resize( int amountCurves ) {
+	int previous = this->vertices.size();
+	if( amountCurves < previous ){
+		// forgetting the removed curves
+		int kept = 0;
+		for( int k = 0; k < this->dirtyCurves.size(); k++ ){
+			if( this->dirtyCurves[k] < amountCurves ){
+				this->dirtyCurves[kept++] = this->dirtyCurves[k];
+			}
+		}
+		this->dirtyCurves.resize( kept );
+	}
+	this->vertices.resize( amountCurves );
+	this->dirty.resize( amountCurves, 0 );
+	// the new curves start dirty
+	for( int i = previous; i < amountCurves; i++ ){
+		this->markDirty( i );
+	}
+}
+
+template<typename T>
+int tessellationCacheT<T>::size() const {
+	return this->vertices.size();
+}
+
+template<typename T>
+void tessellationCacheT<T>::markDirty( int curve ) {
+	if( curve >= 0 && curve < this->dirty.size() && !this->dirty[curve] ){
+		this->dirty[curve] = 1;
+		this->dirtyCurves.push_back( curve );
+	}
+}
+
+template<typename T>
+void tessellationCacheT<T>::markAllDirty() {
+	for( int i = 0; i < this->dirty.size(); i++ ){
+		this->markDirty( i );
+	}
+}
+
+template<typename T>
+bool tessellationCacheT<T>::isDirty( int curve ) const {
+	return this->dirty[curve] != 0;
+}
+
+template<typename T>
+void tessellationCacheT<T>::update( tessellationPool & pool, const std::function<void(int, std::vector< vector3<T> > &)> & tessellate ) {
+	if( this->dirtyCurves.empty() ){
+		return;
+	}
+
+	pool.parallelFor( this->dirtyCurves.size(), 1, [&]( int begin, int end ){
+		for( int k = begin; k < end; k++ ){
+			int i = this->dirtyCurves[k];
+			tessellate( i, this->vertices[i] );
+			this->dirty[i] = 0;
+		}
+	} );
+	this->recomputed += this->dirtyCurves.size();
+	PROFILE_COUNT( counterCurvesTessellated, this->dirtyCurves.size() );
+	this->dirtyCurves.clear();
+}
+
+template<typename T>
+std::vector< vector3<T> > & tessellationCacheT<T>::getVertices( int curve ) {
+	return this->vertices[curve];
+}
+
+template<typename T>
+long long tessellationCacheT<T>::getRecomputed() const {
+	return this->recomputed;
+}
+
+// the two precisions of vector3
+template class tessellationCacheT<double>;
+template class tessellationCacheT<float>;
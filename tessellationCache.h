@@ -0,0 +1,39 @@
+#include <vector>
+#include <functional>
+#include "vec3.h"
+#include "parallelTessellation.h"
+
+#pragma once
+
+// Tessellated vertices of each curve, recomputed only for the curves marked dirty since the last update().
+// Instantiated for vec3 (tessellationCache) and vec3f (tessellationCacheF, half the memory)
+template<typename T>
+class tessellationCacheT
+{
+private:
+	std::vector< std::vector< vector3<T> > > vertices;
+	std::vector<char> dirty;
+	std::vector<int> dirtyCurves;		// curves marked dirty, so update() does not scan the clean ones
+	long long recomputed = 0;
+
+public:
+	tessellationCacheT();
+
+	void resize( int amountCurves );
+	int size() const;
+
+	// to be called by the edits (and the continuity fix-ups) for every curve they change
+	void markDirty( int curve );
+	void markAllDirty();
+	bool isDirty( int curve ) const;
+
+	// recomputes the dirty curves in parallel, tessellate( i, vertices ) replaces the vertices of curve i
+	void update( tessellationPool & pool, const std::function<void(int, std::vector< vector3<T> > &)> & tessellate );
+
+	std::vector< vector3<T> > & getVertices( int curve );
+	// amount of curves recomputed by update() since the creation
+	long long getRecomputed() const;
+};
+
+typedef tessellationCacheT<double> tessellationCache;
+typedef tessellationCacheT<float> tessellationCacheF;
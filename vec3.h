@@ -1,44 +1,81 @@
 #include <string>
+#include <sstream>
+#include <math.h>
 
 #pragma once
 #define PI 3.14159265
 
-class vec3
+// Header-only value type, templated on the scalar: trivially copyable, constexpr and const-correct,
+// so it inlines in every evaluator. vec3 (double) is the reference path, vec3f (float) halves the memory traffic
+template<typename T>
+class vector3
 {
 private:
-	double x = 0, y = 0, z = 0;	// coordonnees du vec3
+	T x = 0, y = 0, z = 0;	// coordonnees du vec3
 
 public:
-	vec3();
-	vec3( double x, double y, double z );
-	~vec3();
-
-	double getX();
-	double getY();
-	double getZ();
-
-	void set( double x, double y, double z );
-	void setX( double x );
-	void setY( double y );
-	void setZ( double z );
-
-	vec3 addition( vec3 a );
-	vec3 negative();
-	vec3 soustraction( vec3 a );
-	vec3 multiplication( vec3 a );
-	vec3 multiplication( double valeur );
-	vec3 division( vec3 a );
-	vec3 division( double valeur );
-	double norme();
-	double normeCarre();
-	vec3 normalized();
-	double produitScalaire( vec3 a );
-	vec3 produitVectoriel( vec3 a );
-
-	vec3 vectorFrom( vec3 origin );
-
-	vec3 normal( double angleDegrees );
-
-	std::string toString();
+	typedef T scalar;
+
+	constexpr vector3() {}
+	constexpr vector3( T x, T y, T z ) : x( x ), y( y ), z( z ) {}
+	// conversion between precisions (vec3f( someVec3 ) rounds each coordinate)
+	template<typename U>
+	explicit constexpr vector3( const vector3<U> & a ) : x( (T)a.getX() ), y( (T)a.getY() ), z( (T)a.getZ() ) {}
+
+	constexpr T getX() const { return this->x; }
+	constexpr T getY() const { return this->y; }
+	constexpr T getZ() const { return this->z; }
+
+	constexpr void set( T x, T y, T z ) { this->x = x; this->y = y; this->z = z; }
+	constexpr void setX( T x ) { this->x = x; }
+	constexpr void setY( T y ) { this->y = y; }
+	constexpr void setZ( T z ) { this->z = z; }
+
+	constexpr vector3 addition( const vector3 & a ) const { return vector3( this->x + a.x, this->y + a.y, this->z + a.z ); }
+	constexpr vector3 negative() const { return vector3( -this->x, -this->y, -this->z ); }
+	constexpr vector3 soustraction( const vector3 & a ) const { return vector3( this->x - a.x, this->y - a.y, this->z - a.z ); }
+	constexpr vector3 multiplication( const vector3 & a ) const { return vector3( this->x * a.x, this->y * a.y, this->z * a.z ); }
+	constexpr vector3 multiplication( T valeur ) const { return vector3( this->x * valeur, this->y * valeur, this->z * valeur ); }
+	constexpr vector3 division( const vector3 & a ) const { return vector3( this->x / a.x, this->y / a.y, this->z / a.z ); }
+	constexpr vector3 division( T valeur ) const { return vector3( this->x / valeur, this->y / valeur, this->z / valeur ); }
+	T norme() const { return sqrt( this->normeCarre() ); }
+	constexpr T normeCarre() const { return this->x*this->x + this->y*this->y + this->z*this->z; }
+	vector3 normalized() const { return this->division( this->norme() ); }
+	constexpr T produitScalaire( const vector3 & a ) const { return this->x * a.x + this->y * a.y + this->z * a.z; }
+	constexpr vector3 produitVectoriel( const vector3 & a ) const {
+		return vector3(	this->y * a.z - a.y * this->z,
+		                this->x * a.z - a.x * this->z,
+		                this->x * a.y - a.x * this->y );
+	}
+
+	constexpr vector3 vectorFrom( const vector3 & origin ) const { return this->soustraction( origin ); }
+
+	vector3 normal( T angleDegrees ) const {
+		return (this->multiplication( cos( angleDegrees * PI / 180 ) )).multiplication( -1. ).normalized();
+	}
+
+	std::string toString() const {
+		std::ostringstream o;
+		o << "( " << this->x << " , " << this->y << " , " << this->z << " )";
+		return o.str();
+	}
+
+	// operators, same arithmetic as the named methods
+	constexpr vector3 operator+( const vector3 & a ) const { return this->addition( a ); }
+	constexpr vector3 operator-( const vector3 & a ) const { return this->soustraction( a ); }
+	constexpr vector3 operator-() const { return this->negative(); }
+	constexpr vector3 operator*( T valeur ) const { return this->multiplication( valeur ); }
+	constexpr vector3 operator/( T valeur ) const { return this->division( valeur ); }
+	constexpr vector3 & operator+=( const vector3 & a ) { this->x += a.x; this->y += a.y; this->z += a.z; return *this; }
+	constexpr vector3 & operator-=( const vector3 & a ) { this->x -= a.x; this->y -= a.y; this->z -= a.z; return *this; }
+	constexpr vector3 & operator*=( T valeur ) { this->x *= valeur; this->y *= valeur; this->z *= valeur; return *this; }
+	constexpr vector3 & operator/=( T valeur ) { this->x /= valeur; this->y /= valeur; this->z /= valeur; return *this; }
+	constexpr bool operator==( const vector3 & a ) const { return this->x == a.x && this->y == a.y && this->z == a.z; }
+	constexpr bool operator!=( const vector3 & a ) const { return !( *this == a ); }
 };
 
+template<typename T>
+constexpr vector3<T> operator*( typename vector3<T>::scalar valeur, const vector3<T> & a ) { return a.multiplication( valeur ); }
+
+typedef vector3<double> vec3;
+typedef vector3<float> vec3f;